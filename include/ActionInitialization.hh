@@ -2,14 +2,27 @@
 #define ActionInitialization_h 1
 
 #include "G4VUserActionInitialization.hh"
+#include "globals.hh"
+
+class StackingRules;
+class TerminationCuts;
 
 class ActionInitialization : public G4VUserActionInitialization {
   public:
-    ActionInitialization();
+    // profile: registra el perfil de pasos (StepProfiler)
+    ActionInitialization(G4bool profile = false);
     ~ActionInitialization() override;
 
     void BuildForMaster() const override;
     void Build() const override;
+
+  private:
+    // Reglas de la StackingAction: compartidas por los hilos, configuradas
+    // en el master con /stack/
+    StackingRules* fStackingRules;
+    // Cortes de terminación de neutrones, configurados en el master con /cuts/
+    TerminationCuts* fTerminationCuts;
+    G4bool fProfile;
 };
 
 #endif
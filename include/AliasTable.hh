@@ -0,0 +1,36 @@
+#ifndef AliasTable_h
+#define AliasTable_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+// Muestreo de una distribución discreta en tiempo constante (método de
+// alias de Walker/Vose): la tabla se construye una vez en O(n) y cada
+// muestra usa un solo número aleatorio, sin búsquedas.
+class AliasTable {
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<G4double>& weights) { Build(weights); }
+
+    // Pesos no negativos (no hace falta normalizarlos)
+    void Build(const std::vector<G4double>& weights);
+
+    // Índice muestreado a partir de u uniforme en [0,1)
+    std::size_t Sample(G4double u) const
+    {
+        G4double x = u * fProbability.size();
+        std::size_t i = std::size_t(x);
+        if (i >= fProbability.size()) i = fProbability.size() - 1;
+        return (x - i < fProbability[i]) ? i : fAlias[i];
+    }
+
+    std::size_t Size() const { return fProbability.size(); }
+    G4bool IsEmpty() const { return fProbability.empty(); }
+
+private:
+    std::vector<G4double> fProbability;
+    std::vector<std::size_t> fAlias;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef AsyncWriter_h
+#define AsyncWriter_h 1
+
+#include "globals.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Hilo de escritura en segundo plano para la salida columnar.
+//
+// Los hilos de tracking entregan lotes de bloques (un bloque = los bytes a
+// agregar al final de un archivo) y siguen trabajando; un único hilo de
+// escritura, compartido por todo el proceso, los comprime (opcional, zlib)
+// y los escribe. La cola tiene kMaxBatches lotes como máximo: si se llena,
+// Push espera (contrapresión), así que la memoria queda acotada aunque el
+// disco sea más lento que la simulación.
+//
+// Bloque comprimido en disco: [uint32 bytes crudos][uint32 bytes
+// comprimidos][datos deflate]; los archivos son concatenaciones de bloques.
+class AsyncWriter {
+public:
+    struct Block {
+        G4String file;
+        std::vector<char> data;
+        G4bool compress = false;
+    };
+
+    static AsyncWriter& Instance();
+
+    // Encola un lote (lo mueve); espera si la cola está llena
+    void Push(std::vector<Block>&& batch);
+    // Espera a que todo lo encolado esté en disco
+    void Drain();
+    // ¿Falló alguna escritura en este archivo? El error se conserva hasta
+    // ClearFailure (cada escritor consulta sólo sus propios archivos)
+    G4bool HasFailed(const G4String& file);
+    void ClearFailure(const G4String& file);
+
+    // ¿Se compiló con zlib? (sin zlib los bloques se escriben crudos)
+    static G4bool HasCompression();
+
+private:
+    AsyncWriter();
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void Loop();
+    static G4bool Write(const Block& block);
+
+    static constexpr std::size_t kMaxBatches = 8;
+
+    std::mutex fMutex;
+    std::condition_variable fNotEmpty;
+    std::condition_variable fNotFull;
+    std::condition_variable fIdle;
+    std::deque<std::vector<Block>> fQueue;
+    G4bool fBusy = false;     // el hilo de escritura tiene un lote en la mano
+    G4bool fStop = false;
+    std::set<G4String> fFailed;   // archivos con escrituras fallidas
+    std::thread fThread;
+};
+
+#endif
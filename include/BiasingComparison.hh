@@ -0,0 +1,23 @@
+#ifndef BiasingComparison_h
+#define BiasingComparison_h 1
+
+#include "globals.hh"
+
+class ImportanceWorld;
+
+// Compara un run análogo (todas las importancias a 1) con uno con muestreo
+// por importancia, con el mismo número de eventos: fracción transmitida en
+// la primera banda (térmicos), su error relativo y la figura de mérito
+// 1/(R²·T).
+class BiasingComparison {
+public:
+    BiasingComparison(ImportanceWorld* world);
+    ~BiasingComparison() = default;
+
+    void Run(G4int nEvents, const G4String& outputFile = "biasing_compare.csv");
+
+private:
+    ImportanceWorld* fWorld;
+};
+
+#endif
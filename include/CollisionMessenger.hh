@@ -0,0 +1,33 @@
+#ifndef CollisionMessenger_h
+#define CollisionMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class CollisionRecorder;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+
+// Comandos /collisions/ del registro de historias de colisiones. Cada hilo
+// (y el master) tiene su CollisionRecorder y su messenger; los comandos se
+// reenvían a los hilos de trabajo.
+class CollisionMessenger : public G4UImessenger {
+public:
+    CollisionMessenger(CollisionRecorder* recorder);
+    ~CollisionMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    CollisionRecorder* fRecorder;
+
+    G4UIdirectory* fCollisionsDir;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithADouble* fSampleCmd;
+    G4UIcmdWithAnInteger* fArenaCmd;
+};
+
+#endif
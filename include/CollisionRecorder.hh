@@ -0,0 +1,114 @@
+#ifndef CollisionRecorder_h
+#define CollisionRecorder_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CollisionMessenger;
+class ColumnarWriter;
+
+// Historias de colisiones de los neutrones en el bloque (/collisions/):
+// en cada colisión hadrónica dentro de Block (FluxSD) se agrega un registro
+// compacto con la energía después de la colisión, el tiempo, la posición,
+// el peso y el núcleo blanco, todo en float32 salvo el blanco (ZA) y el
+// tipo de proceso. Reemplaza a /tracking/verbose para estudiar la
+// termalización colisión por colisión.
+//
+// Los registros van a una arena del hilo de tamaño fijo, reservada al
+// comienzo del run y vaciada en cada evento: durante el tracking no se
+// pide memoria. Al final del evento (EventAction) se escriben sólo las
+// historias de los neutrones que llegaron al detector y una fracción de las
+// demás. Con muestreo por importancia (-b) el neutrón detectado suele ser
+// un clon: se escriben también las historias de todos sus antecesores
+// (las colisiones previas a cada división). El resto se descarta con la
+// arena. La salida usa ColumnarWriter en <nombre>_collisions/ (una fila
+// por colisión).
+class CollisionRecorder {
+public:
+    CollisionRecorder();
+    ~CollisionRecorder();
+
+    // --- Configuración (comandos /collisions/) ---
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    G4bool IsEnabled() const { return fEnabled; }
+    // Fracción de las historias no detectadas que también se escriben
+    void SetSampleFraction(G4double value) { fSample = value; }
+    // Registros por evento; los que no entran se pierden (y se avisa)
+    void SetArenaSize(G4int records) { fArenaSize = records; }
+    void SetCompression(G4bool value);
+
+    // --- Run (hilo dueño) ---
+    void Open(const G4String& directory);
+    void Close();
+    // Master, después de Close(): une las partes de los hilos
+    std::size_t Merge(G4int nThreads);
+    G4bool IsRecording() const { return fRecording; }
+
+    // --- Llenado (FluxSD) ---
+    // Traza que da el paso actual (en cada paso en el bloque, con o sin
+    // colisión: guarda el vínculo con la madre aunque no choque)
+    void SetTrack(G4int trackID, G4int parentID);
+    // Colisión de la traza actual: energía con la que llegó, estado después
+    // de la colisión, ZA del blanco (1000·Z + A; 0 si no se conoce) y
+    // subtipo del proceso hadrónico
+    void AddCollision(G4double energyIn, G4double energy, G4double time,
+                      const G4ThreeVector& position, G4double weight,
+                      G4int targetZA, G4int processSubType);
+
+    // --- Fin de evento (EventAction) ---
+    // Escribe las historias seleccionadas (detectadas, antecesoras de una
+    // detectada o muestreadas) y vacía la arena. detected: pares (ID, ID de
+    // la madre) de las trazas que llegaron al detector.
+    void EndOfEvent(G4int eventID, const std::vector<std::pair<G4int, G4int>>& detected);
+
+private:
+    // 32 bytes por colisión
+    struct Record {
+        float energyIn;         // antes de la colisión (eV)
+        float energy;           // después de la colisión (eV)
+        float time;             // tiempo global (ns)
+        float x, y, z;          // mm
+        float weight;
+        std::uint16_t targetZA;
+        std::uint8_t process;   // subtipo hadrónico (G4HadronicProcessType)
+        std::uint8_t pad;
+    };
+
+    // Registros contiguos de una traza en la arena
+    struct History {
+        G4int trackID;
+        G4int parentID;
+        std::size_t first;
+    };
+
+    G4bool IsSampled(G4int eventID, G4int trackID) const;
+    void WriteHistory(G4int eventID, const History& history, std::size_t end, G4int detected);
+
+    CollisionMessenger* fMessenger;
+    ColumnarWriter* fWriter;
+
+    G4bool fEnabled = false;
+    G4bool fRecording = false;
+    G4double fSample = 0.;
+    G4int fArenaSize = 65536;
+
+    // Arena del evento: capacidad fija, se vacía sin liberar memoria
+    std::vector<Record> fArena;
+    std::vector<History> fHistories;
+    G4int fTrackID = -1;
+
+    // Selección del fin de evento: madre de cada traza y marca de las
+    // seleccionadas (1: detectada, 2: antecesora); se vacían sin liberar
+    std::unordered_map<G4int, G4int> fParents;
+    std::unordered_map<G4int, G4int> fSelected;
+
+    // Registros perdidos por arena llena en el run (se avisa en Close)
+    std::size_t fDropped = 0;
+};
+
+#endif
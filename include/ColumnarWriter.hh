@@ -0,0 +1,100 @@
+#ifndef ColumnarWriter_h
+#define ColumnarWriter_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Salida columnar compacta para la ntuple por neutrón.
+//
+// Cada columna se guarda en un archivo binario crudo (<columna>.bin) con
+// tipo fijo: int32, float32 o un código uint8 para textos repetidos
+// (volumen, proceso). schema.json describe el número de filas, el dtype de
+// numpy de cada archivo y las etiquetas de las columnas enumeradas, así que
+// Python los abre con np.memmap sin leer ni convertir nada.
+//
+// Cada hilo acumula filas en memoria y entrega bloques de kChunkRows filas
+// al hilo de escritura (AsyncWriter), que los agrega a las partes del hilo
+// en segundo plano; al final del run el master concatena las partes de
+// todos los hilos y escribe el esquema.
+//
+// Con compresión (/output/compress, requiere zlib) cada bloque se guarda
+// comprimido y schema.json lo indica con "compression": "zlib"; esos
+// archivos ya no se abren con np.memmap sino con macros/columnar.py.
+class ColumnarWriter {
+public:
+    enum ColumnType { kInt32, kFloat32, kEnum8 };
+
+    explicit ColumnarWriter(const G4String& name);
+    ~ColumnarWriter() = default;
+
+    // Definición de columnas: debe ser idéntica en todos los hilos
+    G4int CreateColumn(const G4String& name, ColumnType type);
+
+    // Compresión zlib de los bloques (se ignora si no se compiló con zlib)
+    void SetCompression(G4bool value);
+
+    void Open(const G4String& directory);
+    void Close();
+    G4bool IsOpen() const { return fOpen; }
+
+    // --- Llenado (el ID de columna es el orden de creación) ---
+    void FillI(G4int column, G4int value)    { Append(column, std::int32_t(value)); }
+    void FillF(G4int column, G4double value) { Append(column, float(value)); }
+    void FillEnum(G4int column, const G4String& label) { Append(column, EnumCode(column, label)); }
+    void AddRow();
+
+    // Master, después de Close(): concatena las partes de los hilos
+    // (en orden de hilo) y escribe schema.json. Devuelve el número de filas.
+    std::size_t Merge(G4int nThreads);
+
+private:
+    struct Column {
+        G4String name;
+        ColumnType type;
+        std::vector<char> buffer;  // filas del bloque actual
+    };
+
+    template <typename T>
+    void Append(G4int column, T value)
+    {
+        auto& buffer = fColumns[column].buffer;
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    std::uint8_t EnumCode(G4int column, const G4String& label);
+    void FlushChunk();
+    G4String PartFile(G4int column, G4int threadID) const;
+    void WriteSchema(std::size_t rows) const;
+    std::size_t RawSize(const G4String& fileName, std::size_t fileSize) const;
+
+    static std::size_t TypeSize(ColumnType type);
+    static G4String TypeName(ColumnType type);
+
+    static constexpr std::size_t kChunkRows = 65536;
+    static constexpr std::uint8_t kOtherCode = 255;  // etiquetas más allá de 255
+
+    G4String fName;
+    G4String fDirectory;
+    G4bool fOpen = false;
+    G4bool fCompress = false;
+    G4int fThreadID = -1;
+    std::size_t fRowsInChunk = 0;
+    std::vector<Column> fColumns;
+
+    // Caché local del hilo: etiqueta -> código
+    std::vector<std::unordered_map<std::string, std::uint8_t>> fEnumCache;
+
+    // Diccionarios compartidos por todos los hilos ("ntuple/columna" ->
+    // etiquetas), para que un código signifique lo mismo en todas las partes
+    static std::mutex fgEnumMutex;
+    static std::map<G4String, std::vector<G4String>> fgEnumLabels;
+};
+
+#endif
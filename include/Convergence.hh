@@ -0,0 +1,50 @@
+#ifndef Convergence_h
+#define Convergence_h 1
+
+#include "RunAction.hh"
+#include "globals.hh"
+
+class ConvergenceMessenger;
+
+// Largo de run adaptativo (/convergence/): los eventos se corren en lotes
+// y después de cada lote se mira el error relativo de un conteo (una banda
+// de /tally/bands o el total de detectados). El run termina al llegar al
+// error pedido, al presupuesto de tiempo o al máximo de eventos.
+//
+// El tamaño del lote se estima con el error actual (R ∝ 1/sqrt(N)) y se
+// limita a duplicar los eventos hechos, porque con pocos conteos la
+// estimación es ruidosa. Lo usan /driver/beamOn y /detector/sweep/run.
+class Convergence {
+public:
+    Convergence();
+    ~Convergence();
+
+    // --- Configuración ---
+    void SetTargetError(G4double value) { fTarget = value; }   // 0: sin objetivo
+    void SetTally(G4int band) { fTally = band; }                // -1: detectados
+    void SetMaxTime(G4double seconds) { fMaxTime = seconds; }   // 0: sin límite
+    void SetBatch(G4int events) { fBatch = events; }
+
+    // Sin objetivo ni presupuesto se corren siempre todos los eventos
+    G4bool IsActive() const { return fTarget > 0. || fMaxTime > 0.; }
+
+    // Eventos del próximo lote dadas las sumas de los lotes hechos (0: parar)
+    G4int NextBatch(const RunAction::Tallies& tallies, G4int maxEvents);
+    // Error relativo del conteo elegido
+    G4double GetRelativeError(const RunAction::Tallies& tallies) const;
+    // Motivo de la última parada ("error", "tiempo" o "eventos")
+    const G4String& GetReason() const { return fReason; }
+
+    void Print(const RunAction::Tallies& tallies) const;
+
+private:
+    ConvergenceMessenger* fMessenger;
+
+    G4double fTarget = 0.;
+    G4int fTally = 0;          // por defecto la primera banda (térmicos)
+    G4double fMaxTime = 0.;    // segundos de run (suma de los lotes)
+    G4int fBatch = 10000;      // primer lote y tamaño mínimo
+    G4String fReason;
+};
+
+#endif
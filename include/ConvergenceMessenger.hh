@@ -0,0 +1,30 @@
+#ifndef ConvergenceMessenger_h
+#define ConvergenceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class Convergence;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+
+class ConvergenceMessenger : public G4UImessenger {
+public:
+    ConvergenceMessenger(Convergence* convergence);
+    ~ConvergenceMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    Convergence* fConvergence;
+
+    G4UIdirectory* fConvergenceDir;  // carpeta /convergence/
+    G4UIcmdWithADouble* fTargetCmd;
+    G4UIcmdWithAnInteger* fTallyCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxTimeCmd;
+    G4UIcmdWithAnInteger* fBatchCmd;
+};
+
+#endif
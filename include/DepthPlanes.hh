@@ -0,0 +1,108 @@
+#ifndef DepthPlanes_h
+#define DepthPlanes_h 1
+
+#include "G4VAccumulable.hh"
+#include "G4VUserTrackInformation.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+class DepthPlanesMessenger;
+class G4Step;
+class G4Track;
+
+// Planos que ya cruzó la traza madre cuando nació un neutrón secundario
+// (clones del muestreo por importancia, (n,2n), ...). Con /planes/firstCrossing
+// el secundario los hereda: en la placa equivalente su madre ya había salido.
+class PlaneCrossings : public G4VUserTrackInformation {
+public:
+    explicit PlaneCrossings(std::uint64_t crossed) : fCrossed(crossed) {}
+    ~PlaneCrossings() override = default;
+
+    std::uint64_t fCrossed;   // un bit por plano
+};
+
+// Planos de puntaje virtuales dentro del bloque, a profundidades dadas
+// desde la cara de entrada (/planes/). Cada neutrón que cruza un plano
+// hacia adelante (+z) suma su peso a la banda de /tally/bands y a un
+// espectro logarítmico de ese plano. Un solo run con un bloque grueso da
+// la fracción térmica vs profundidad sin barrer espesores.
+//
+// Por defecto sólo cuenta el primer cruce de cada neutrón por cada plano:
+// hasta ese momento su historia es la misma que en una placa cuyo espesor
+// es la profundidad del plano, así que el conteo equivale a lo que sale
+// por la cara trasera de esa placa (ver README, "Planos de profundidad").
+//
+// Los secundarios (incluidos los clones del muestreo por importancia)
+// heredan los planos ya cruzados por su madre (PlaneCrossings), así que
+// tampoco cuentan otra vez un plano que la madre ya cruzó.
+//
+// Los cruces se buscan en los pasos de FluxSD (rectos, sin campo), sin un
+// mundo paralelo. Es un acumulable como FluxMesh.
+class DepthPlanes : public G4VAccumulable {
+public:
+    static const G4String kName;   // nombre en el AccumulableManager
+
+    static constexpr G4int kMaxPlanes = 64;       // un bit por plano y traza
+    static constexpr G4int kSpectrumBins = 100;   // 10 por década, 1 meV a 10 MeV
+
+    DepthPlanes();
+    ~DepthPlanes() override;
+
+    // --- Configuración (comandos /planes/) ---
+    // Profundidades desde la cara de entrada, en orden creciente
+    G4bool SetDepths(const std::vector<G4double>& depths);
+    void SetFirstCrossing(G4bool value) { fFirstCrossing = value; }
+    // Media apertura cuadrada centrada en el eje (0: toda la cara del bloque)
+    void SetAperture(G4double halfWidth) { fAperture = halfWidth; }
+    G4bool IsEnabled() const { return !fZ.empty(); }
+    G4bool IsFirstCrossing() const { return fFirstCrossing; }
+
+    // Cara de entrada del bloque y bandas del run; (re)dimensiona los
+    // arreglos. Se llama al comienzo de cada run, antes del Reset.
+    void SetGeometry(G4double halfZ, const std::vector<G4double>& bandEdges);
+
+    // --- Llenado (hilo dueño) ---
+    // Paso recto de a a b de la traza dada, con energía y peso
+    void Score(const G4Track* track, const G4ThreeVector& a, const G4ThreeVector& b,
+               G4double kineticEnergy, G4double weight);
+    // Pasa los planos cruzados por la traza en curso a los neutrones
+    // secundarios del paso (sólo con firstCrossing)
+    void PassToSecondaries(const G4Step* step) const;
+    void EndOfEvent();
+
+    // --- G4VAccumulable ---
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    // Por plano y banda: neutrones por neutrón fuente, error y fracción en
+    // <base>_planes.csv; espectros en <base>_planes_spectra.csv
+    void Write(const G4String& base, G4int nEvents, const std::vector<G4String>& bandLabels) const;
+
+private:
+    DepthPlanesMessenger* fMessenger;
+
+    std::vector<G4double> fDepths;   // configuradas (orden creciente)
+    G4bool fFirstCrossing = true;
+    G4double fAperture = 0.;
+
+    // Planos dentro del bloque en este run y sus posiciones en z
+    G4double fHalfZ = 0.;
+    std::vector<G4double> fZ;
+    std::vector<G4double> fBandEdges;
+    G4int fNumberOfBands = 1;
+
+    // Traza en curso: planos que ya cruzó (un bit por plano)
+    G4int fTrackID = -1;
+    std::uint64_t fCrossed = 0;
+
+    std::vector<G4double> fSum;        // Σ peso por [plano][banda]
+    std::vector<G4double> fSumSq;      // Σ (peso del evento)²
+    std::vector<G4double> fEvent;      // puntaje del evento actual
+    std::vector<std::size_t> fTouched;
+    std::vector<G4double> fSpectrum;   // Σ peso por [plano][bin de energía]
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef DepthPlanesMessenger_h
+#define DepthPlanesMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class DepthPlanes;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+// Comandos /planes/ de los planos de profundidad. Cada hilo (y el master)
+// tiene sus DepthPlanes y su messenger; los comandos se reenvían a los
+// hilos de trabajo.
+class DepthPlanesMessenger : public G4UImessenger {
+public:
+    DepthPlanesMessenger(DepthPlanes* planes);
+    ~DepthPlanesMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    DepthPlanes* fPlanes;
+
+    G4UIdirectory* fPlanesDir;
+    G4UIcmdWithAString* fDepthsCmd;
+    G4UIcommand* fUniformCmd;
+    G4UIcmdWithABool* fFirstCrossingCmd;
+    G4UIcmdWithADoubleAndUnit* fApertureCmd;
+};
+
+#endif
@@ -2,9 +2,24 @@
 #define DetectorConstruction_h 1
 
 #include "G4VPhysicalVolume.hh"
+#include "G4ThreeVector.hh"
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 class DetectorMessenger;
+class ImportanceWorld;
+class G4Box;
+class G4UserLimits;
+
+// Política de límite de paso por volumen (aplicada por G4StepLimiter)
+enum StepLimitPolicy {
+    kNoStepLimit,        // sin límite
+    kFixedStepLimit,     // límite en todo el volumen
+    kBoundaryStepLimit   // límite sólo en una capa junto al detector
+};
+
+// Volúmenes con política de límite de paso
+enum StepLimitVolume { kWorldVolume = 0, kBlockVolume, kDetectorVolume, kNumStepLimitVolumes };
+
 class DetectorConstruction : public G4VUserDetectorConstruction {
 public:
     DetectorConstruction();
@@ -17,21 +32,91 @@ public:
     void ConstructSDandField() override;
 
     // --- NUEVOS MÉTODOS: para modificar las dimensiones del bloque de parafina ---
-    void SetParaffinX(G4double val) { fParaffinX = val; }
-    void SetParaffinY(G4double val) { fParaffinY = val; }
-    void SetParaffinZ(G4double val) { fParaffinZ = val; }
+    // Si la geometría ya fue construida, se actualiza en el lugar (sin Construct()).
+    void SetParaffinX(G4double val);
+    void SetParaffinY(G4double val);
+    void SetParaffinZ(G4double val);
+
+    // Detector segmentado en nx x ny píxeles de lado pitch (nx = 0: detector
+    // único). Cambia la estructura: reconstruye la geometría si ya existe.
+    G4bool SetPixels(G4int nx, G4int ny, G4double pitch);
+    G4int GetPixelsX() const { return fPixels[0]; }
+    G4int GetPixelsY() const { return fPixels[1]; }
+    G4double GetPixelPitch() const { return fPixelPitch; }
+
+    // Redimensiona el bloque y reubica el detector sin reconstruir el mundo
+    void UpdateGeometry();
 
     // (Opcional: getters si los necesitas)
     G4double GetParaffinX() const { return fParaffinX; }
     G4double GetParaffinY() const { return fParaffinY; }
     G4double GetParaffinZ() const { return fParaffinZ; }
 
+    // --- Límites de paso por volumen ---
+    // Cambiar a/desde "boundary" cambia la estructura y reconstruye la geometría.
+    void SetStepLimitPolicy(StepLimitVolume volume, StepLimitPolicy policy);
+    void SetMaxStep(StepLimitVolume volume, G4double val);
+    void SetBoundaryMargin(G4double val);
+    StepLimitPolicy GetStepLimitPolicy(StepLimitVolume volume) const { return fStepPolicy[volume]; }
+    static G4String GetStepLimitPolicyName(StepLimitPolicy policy);
+
+    // Mundo paralelo de importancias (opcional, main.cc con -b): se registra
+    // como mundo paralelo y sus capas siguen al bloque al redimensionarlo
+    void SetImportanceWorld(ImportanceWorld* world);
+
+    // Hidrógeno de la parafina como TS_H_of_Polyethylene, para la
+    // dispersión térmica S(α,β) de NeutronHP_TS (antes de /run/initialize)
+    void SetThermalScattering(G4bool val) { fThermalScattering = val; }
+
+    // Tiempo real (s) de la última llamada a Construct()
+    G4double GetConstructionTime() const { return fConstructionTime; }
+
+    // Posición en z del centro del detector (justo después de la parafina)
+    G4double GetDetectorZ() const;
+    // Medias longitudes del detector plano (o de la matriz de píxeles)
+    G4ThreeVector GetDetectorHalfSize() const;
+
 private:
+
+    // Capas de límite de paso junto al detector (política "boundary")
+    G4double GetGuardHalfZ() const;
+    G4double GetBlockExitHalfZ() const;
+
+    // Asigna los G4UserLimits según las políticas actuales
+    void ApplyStepLimits();
+
+    // Destruye la geometría para que se reconstruya en el siguiente run
+    void ReinitializeGeometry();
+
     // --- NUEVAS VARIABLES: medias longitudes del bloque de parafina ---
     G4double fParaffinX;
     G4double fParaffinY;
     G4double fParaffinZ;
     DetectorMessenger* fMessenger;
+
+    // Volúmenes que cambian al modificar el bloque (nullptr antes de Construct)
+    G4Box* fSolidBlock;
+    G4VPhysicalVolume* fPhysDetector;   // detector, o su capa de guarda si existe
+    G4Box* fSolidBlockExit;             // capa de salida del bloque ("boundary")
+    G4VPhysicalVolume* fPhysBlockExit;
+
+    // Matriz de píxeles (/detector/pixels): réplicas en x (columnas) y en y
+    G4int fPixels[2];
+    G4double fPixelPitch;
+    G4LogicalVolume* fLogicPixel;       // píxel (nullptr sin matriz)
+
+    // Límites de paso: política, longitud máxima y objetos G4UserLimits
+    StepLimitPolicy fStepPolicy[kNumStepLimitVolumes];
+    G4double fMaxStep[kNumStepLimitVolumes];
+    G4UserLimits* fStepLimits[kNumStepLimitVolumes];
+    G4double fBoundaryMargin;
+    G4LogicalVolume* fLogicVolume[kNumStepLimitVolumes];  // volumen completo
+    G4LogicalVolume* fLogicLayer[kNumStepLimitVolumes];   // capa junto al detector (o nullptr)
+
+    ImportanceWorld* fImportanceWorld;
+    G4bool fThermalScattering;
+
+    G4double fConstructionTime;
 };
 
 
@@ -7,6 +7,8 @@
 class DetectorConstruction;
 class G4UIdirectory;
 class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcommand;
 
 class DetectorMessenger : public G4UImessenger {
 public:
@@ -22,6 +24,13 @@ private:
     G4UIcmdWithADoubleAndUnit* fParaffinXCmd;
     G4UIcmdWithADoubleAndUnit* fParaffinYCmd;
     G4UIcmdWithADoubleAndUnit* fParaffinZCmd;
+    G4UIcommand* fPixelsCmd;
+
+    G4UIdirectory* fStepLimitDir;  // carpeta /detector/stepLimit/
+    G4UIcommand* fPolicyCmd;
+    G4UIcommand* fMaxStepCmd;
+    G4UIcmdWithADoubleAndUnit* fMarginCmd;
+    G4UIcmdWithAnInteger* fCompareCmd;
 };
 
 #endif
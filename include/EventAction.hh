@@ -2,9 +2,14 @@
 #define EventAction_h 1
 
 #include "G4UserEventAction.hh"
+#include "TransmittedHit.hh"
 #include "globals.hh"
 
+#include <utility>
+#include <vector>
+
 class RunAction;
+class ColumnarWriter;
 
 class EventAction : public G4UserEventAction
 {
@@ -17,7 +22,18 @@ public:
 
 
 private:
+    // Vuelca todos los hits del evento (histograma, conteos y ntuple)
+    void FlushHits(G4int eventID, const TransmittedHitsCollection& hits);
+    void FillNtuple(G4int eventID, const TransmittedHit& hit);
+    void FillColumnar(ColumnarWriter* columnar, G4int eventID, const TransmittedHit& hit);
+
     RunAction* fRunAction;
+    G4int fHCID; // ID de la colección de TransmittedSD (se busca una vez)
+
+    // Suma de pesos del evento por banda de energía (RunAction::kMaxBands)
+    std::vector<G4double> fBandScore;
+    // Trazas que llegaron al detector y sus madres (selección de /collisions/)
+    std::vector<std::pair<G4int, G4int>> fDetectedTracks;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,40 @@
+#ifndef EventSeeder_h
+#define EventSeeder_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+
+class G4Event;
+class SeedMessenger;
+
+// Semillas por evento (/seed/perEvent): antes de generar cada primario el
+// motor aleatorio del hilo se reinicia con semillas derivadas sólo de
+// (semilla maestra, ID del run, ID del evento + desplazamiento). Así cada
+// evento consume la misma secuencia sin importar qué hilo o proceso lo
+// corre, y los runs secuenciales, multihilo y por shards dan los mismos
+// conteos. El desplazamiento numera los eventos de un shard como parte del
+// run lógico completo.
+class EventSeeder {
+public:
+    EventSeeder();
+    ~EventSeeder();
+
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    void SetMasterSeed(G4long value) { fMasterSeed = value; }
+    void SetEventOffset(G4long value) { fEventOffset = value; }
+    G4bool IsEnabled() const { return fEnabled; }
+
+    // Llamado al comienzo de GeneratePrimaries (no hace nada si está desactivado)
+    void Seed(const G4Event* event) const;
+
+private:
+    static std::uint64_t Mix(std::uint64_t x);
+
+    SeedMessenger* fMessenger;
+    G4bool fEnabled = false;
+    G4long fMasterSeed = 12345;
+    G4long fEventOffset = 0;
+};
+
+#endif
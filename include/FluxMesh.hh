@@ -0,0 +1,82 @@
+#ifndef FluxMesh_h
+#define FluxMesh_h 1
+
+#include "G4VAccumulable.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class FluxMessenger;
+
+// Flujo de neutrones por longitud de traza en una malla de vóxeles que
+// cubre el bloque de parafina (centrado en el origen), con bandas de
+// energía logarítmicas. Cada paso de neutrón dentro del bloque suma
+// peso·longitud en los vóxeles que atraviesa (FluxSD).
+//
+// Es un acumulable de Geant4: cada hilo (y el master) tiene el suyo,
+// registrado en RunAction, y el AccumulableManager los suma al final del
+// run. Los puntajes viven en arreglos planos indexados
+// ((banda·nz + iz)·ny + iy)·nx + ix, así que un paso recorre memoria
+// contigua a lo largo de x. Las sumas de cuadrados se llevan por evento
+// (arreglo de scratch + lista de vóxeles tocados) para estimar el error.
+class FluxMesh : public G4VAccumulable {
+public:
+    static const G4String kName;   // nombre en el AccumulableManager
+
+    FluxMesh();
+    ~FluxMesh() override;
+
+    // --- Configuración (comandos /flux/) ---
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    G4bool SetDivisions(G4int nx, G4int ny, G4int nz);
+    G4bool SetEnergyBins(G4int n, G4double eMin, G4double eMax);
+    G4bool IsEnabled() const { return fEnabled; }
+
+    // Mitades del bloque; (re)dimensiona los arreglos si cambió la malla.
+    // Se llama al comienzo de cada run, antes del Reset de los acumulables.
+    void SetExtent(G4double halfX, G4double halfY, G4double halfZ);
+
+    // --- Llenado (hilo dueño) ---
+    // Segmento recto de a a b (coordenadas globales) con energía y peso
+    void Score(const G4ThreeVector& a, const G4ThreeVector& b,
+               G4double kineticEnergy, G4double weight);
+    // Pasa los puntajes del evento a las sumas y sumas de cuadrados
+    void EndOfEvent();
+
+    // --- G4VAccumulable ---
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    // Flujo por neutrón fuente (1/cm²) y error relativo en float32, más un
+    // JSON con la forma y los bordes: <base>_flux.bin, _flux_err.bin, _flux.json
+    void Write(const G4String& base, G4int nEvents) const;
+
+private:
+    G4int VoxelCount() const { return fN[0]*fN[1]*fN[2]; }
+    void Add(std::size_t index, G4double value)
+    {
+        if (fEvent[index] == 0.) fTouched.push_back(index);
+        fEvent[index] += value;
+    }
+
+    FluxMessenger* fMessenger;
+
+    G4bool fEnabled = false;
+    G4int fN[3] = {10, 10, 20};      // vóxeles en x, y, z
+    G4double fHalf[3] = {0., 0., 0.};
+    G4double fInvSize[3] = {0., 0., 0.};   // 1/tamaño del vóxel
+
+    G4int fNumberOfBins = 10;        // bandas logarítmicas de energía
+    G4double fEMin;
+    G4double fEMax;
+    G4double fLogEMin;
+    G4double fInvLogWidth;
+
+    std::vector<G4double> fSum;      // Σ peso·longitud (mm) por evento
+    std::vector<G4double> fSumSq;    // Σ (puntaje del evento)²
+    std::vector<G4double> fEvent;    // puntaje del evento actual
+    std::vector<std::size_t> fTouched;
+};
+
+#endif
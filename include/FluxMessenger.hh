@@ -0,0 +1,30 @@
+#ifndef FluxMessenger_h
+#define FluxMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class FluxMesh;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+
+// Comandos /flux/ de la malla de flujo. Cada hilo (y el master) tiene su
+// FluxMesh y su messenger; los comandos se reenvían a los hilos de trabajo.
+class FluxMessenger : public G4UImessenger {
+public:
+    FluxMessenger(FluxMesh* mesh);
+    ~FluxMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    FluxMesh* fMesh;
+
+    G4UIdirectory* fFluxDir;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcommand* fMeshCmd;
+    G4UIcommand* fEnergyCmd;
+};
+
+#endif
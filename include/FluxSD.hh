@@ -0,0 +1,34 @@
+#ifndef FluxSD_h
+#define FluxSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+class FluxMesh;
+class ThermalizationTally;
+class DepthPlanes;
+class CollisionRecorder;
+class G4ParticleDefinition;
+
+// Puntajes de neutrones dentro del bloque (Block y, si existe, BlockExit):
+// cada paso se reparte entre los vóxeles que cruza (FluxMesh) y cada
+// colisión hadrónica llena el mapa energía-tiempo (ThermalizationTally) y
+// cada cruce de un plano de profundidad suma a DepthPlanes. No crea hits;
+// los tres son acumulables del hilo registrados en RunAction. Con
+// /collisions/enable cada colisión va además al CollisionRecorder del hilo.
+class FluxSD : public G4VSensitiveDetector {
+  public:
+    FluxSD(const G4String& name);
+    ~FluxSD() override;
+    void Initialize(G4HCofThisEvent*) override;
+    G4bool ProcessHits(G4Step* aStep, G4TouchableHistory*) override;
+    void EndOfEvent(G4HCofThisEvent*) override;
+
+  private:
+    FluxMesh* fMesh;                      // acumulables del hilo (se buscan una vez)
+    ThermalizationTally* fThermal;
+    DepthPlanes* fPlanes;
+    CollisionRecorder* fCollisions;       // de la RunAction del hilo
+    const G4ParticleDefinition* fNeutron; // definición cacheada del neutrón
+};
+
+#endif
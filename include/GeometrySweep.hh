@@ -0,0 +1,58 @@
+#ifndef GeometrySweep_h
+#define GeometrySweep_h 1
+
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class SweepMessenger;
+class Convergence;
+
+// Barrido de geometrías dentro de un solo proceso: para cada punto cambia
+// el bloque de parafina en el lugar, mueve el cañón con el espesor, corre
+// /run/beamOn y agrega los conteos térmico/epitérmico/rápido a una tabla.
+// Con /convergence/ activo cada punto corre en lotes hasta el error
+// objetivo (los eventos de /detector/sweep/events son el máximo).
+class GeometrySweep {
+public:
+    GeometrySweep(DetectorConstruction* detector, Convergence* convergence);
+    ~GeometrySweep();
+
+    // Rango de medias longitudes para un eje (0 = X, 1 = Y, 2 = Z)
+    void SetRange(G4int axis, G4double min, G4double max, G4double step);
+
+    // Archivo con un punto por línea: "X Y Z" (medias longitudes en cm)
+    void LoadFile(const G4String& fileName);
+
+    void SetEvents(G4int val) { fEvents = val; }
+    void SetOutputFile(const G4String& val) { fOutputFile = val; }
+    void SetGunOffset(G4double val) { fGunOffset = val; }
+
+    // Ejecuta todos los puntos del barrido
+    void Run();
+
+private:
+    struct Point {
+        G4double x, y, z;
+    };
+
+    std::vector<Point> BuildGrid() const;
+    std::vector<G4double> AxisValues(G4int axis) const;
+
+    DetectorConstruction* fDetector;
+    SweepMessenger* fMessenger;
+    Convergence* fConvergence;
+
+    // Rangos por eje; step <= 0 significa "usar el valor actual del detector"
+    G4double fMin[3];
+    G4double fMax[3];
+    G4double fStep[3];
+
+    std::vector<Point> fFilePoints;  // puntos leídos de archivo (si hay)
+
+    G4int fEvents;
+    G4String fOutputFile;
+    G4double fGunOffset;  // distancia del cañón a la cara de entrada
+};
+
+#endif
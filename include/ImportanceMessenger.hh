@@ -0,0 +1,31 @@
+#ifndef ImportanceMessenger_h
+#define ImportanceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class ImportanceWorld;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithABool;
+
+class ImportanceMessenger : public G4UImessenger {
+public:
+    ImportanceMessenger(ImportanceWorld* world);
+    ~ImportanceMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    ImportanceWorld* fWorld;
+
+    G4UIdirectory* fBiasingDir;  // carpeta /biasing/
+    G4UIcmdWithAnInteger* fCellsCmd;
+    G4UIcmdWithADouble* fRatioCmd;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithAnInteger* fCompareCmd;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef ImportanceWorld_h
+#define ImportanceWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+class ImportanceMessenger;
+class G4Box;
+class G4GeometrySampler;
+class G4VModularPhysicsList;
+class G4VPhysicalVolume;
+
+// Mundo paralelo de celdas de importancia para el muestreo por importancia
+// geométrica (splitting / ruleta rusa de neutrones).
+//
+// El bloque de parafina se divide en capas iguales a lo largo de z; la
+// importancia crece un factor fijo (fRatio) de capa en capa, de modo que
+// los neutrones que avanzan hacia el detector se dividen y los que vuelven
+// hacia la fuente juegan a la ruleta rusa. La región delante del bloque
+// tiene importancia 1 y la de detrás la de la última capa.
+//
+// Las capas siguen al bloque cuando cambia su espesor (UpdateGeometry), así
+// que el barrido de geometrías funciona igual con o sin muestreo.
+class ImportanceWorld : public G4VUserParallelWorld {
+public:
+    ImportanceWorld(DetectorConstruction* detector);
+    ~ImportanceWorld() override;
+
+    void Construct() override;
+
+    // Registra G4ImportanceBiasing y G4ParallelWorldPhysics para este mundo
+    void RegisterPhysics(G4VModularPhysicsList* physicsList);
+
+    // Redimensiona las capas al espesor actual del bloque
+    void UpdateGeometry();
+    // La geometría se va a destruir: olvida los volúmenes hasta Construct()
+    void ResetCells();
+
+    // --- Configuración (/biasing/) ---
+    void SetNumberOfCells(G4int n) { fNumCells = n; }   // antes de /run/initialize
+    void SetRatio(G4double ratio);
+    void SetEnabled(G4bool value);  // false: todas las importancias a 1 (análogo)
+
+    G4int GetNumberOfCells() const { return fNumCells; }
+    G4double GetRatio() const { return fRatio; }
+    G4bool IsEnabled() const { return fEnabled; }
+
+private:
+    // Importancia de la capa i (la última entrada es la región de salida)
+    G4double GetImportance(G4int cell) const;
+    void PlaceCells();
+    void ApplyImportances();
+
+    DetectorConstruction* fDetector;
+    ImportanceMessenger* fMessenger;
+    G4GeometrySampler* fSampler;
+
+    G4int fNumCells;
+    G4double fRatio;
+    G4bool fEnabled;
+
+    // Capas del bloque y región de salida (nullptr/vacío antes de Construct)
+    G4VPhysicalVolume* fGhostWorld;
+    std::vector<G4Box*> fCellSolids;
+    std::vector<G4VPhysicalVolume*> fCells;
+};
+
+#endif
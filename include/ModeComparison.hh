@@ -0,0 +1,59 @@
+#ifndef ModeComparison_h
+#define ModeComparison_h 1
+
+#include "globals.hh"
+
+#include <functional>
+#include <vector>
+
+class RunAction;
+
+// Comparación A/B de un modo de la simulación (reglas de /stack/, cortes
+// de /cuts/, muestreo por importancia, ...): corre el mismo número de
+// eventos con el modo apagado y encendido y reporta tiempo, eventos/s, los
+// contadores propios de cada comparación (columnas extra, leídas de la
+// RunAction después de cada run) y la diferencia de conteos por banda en
+// unidades de sigma. Cada /xxx/compare configura una y la corre.
+class ModeComparison {
+public:
+    using Toggle = std::function<void(G4bool)>;
+    using Counter = std::function<G4double(const RunAction&)>;
+
+    // Nombre corto (CSV y tabla) y descripción de cada modo, y cómo
+    // encenderlo o apagarlo
+    ModeComparison(const G4String& offName, const G4String& offTitle,
+                   const G4String& onName, const G4String& onTitle, Toggle toggle);
+    ~ModeComparison() = default;
+
+    // Columna extra: encabezado del CSV, etiqueta corta de la tabla y valor
+    void AddColumn(const G4String& header, const G4String& label, Counter counter);
+
+    // Los dos runs y el reporte (deja el modo encendido: el que llama
+    // restaura su configuración)
+    void Run(G4int nEvents, const G4String& outputFile);
+
+    // Resultados del último Run (modo 0: apagado, 1: encendido)
+    G4double GetTime(G4int mode) const { return fResults[mode].time; }
+    G4double GetValue(G4int mode, G4int column) const { return fResults[mode].values[column]; }
+
+private:
+    struct Column {
+        G4String header;
+        G4String label;
+        Counter counter;
+    };
+    struct Result {
+        G4double time = 0.;
+        std::vector<G4double> values;   // una por columna extra
+        std::vector<G4double> counts;   // por banda
+        std::vector<G4double> errors;
+    };
+
+    G4String fName[2];
+    G4String fTitle[2];
+    Toggle fToggle;
+    std::vector<Column> fColumns;
+    Result fResults[2];
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef NeutronHPPhysics_h
+#define NeutronHPPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+// Procesos de neutrones con los modelos de alta precisión (HP) en todo el
+// rango: dispersión elástica, inelástica y captura. Con thermalScattering
+// la elástica por debajo de 4 eV usa S(α,β) del hidrógeno en polietileno
+// (el bloque debe usar el elemento TS_H_of_Polyethylene, ver
+// DetectorConstruction::SetThermalScattering). Los datos HP cubren hasta
+// 20 MeV, muy por encima de la fuente de 4.2 MeV.
+class NeutronHPPhysics : public G4VPhysicsConstructor {
+public:
+    NeutronHPPhysics(G4bool thermalScattering = false);
+    ~NeutronHPPhysics() override = default;
+
+    void ConstructParticle() override;
+    void ConstructProcess() override;
+
+private:
+    G4bool fThermalScattering;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef NeutronPhysicsList_h
+#define NeutronPhysicsList_h 1
+
+#include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+// Lista de física reducida para el transporte de neutrones de pocos MeV
+// (opción -p NeutronHP / NeutronHP_TS): NeutronHPPhysics y EM estándar para
+// los secundarios cargados y gammas. Sin modelos hadrónicos de alta
+// energía, física de iones ni decaimientos.
+class NeutronPhysicsList : public G4VModularPhysicsList {
+public:
+    NeutronPhysicsList(G4bool thermalScattering = false);
+    ~NeutronPhysicsList() override = default;
+
+    void ConstructParticle() override;
+};
+
+#endif
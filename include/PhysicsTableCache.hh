@@ -0,0 +1,34 @@
+#ifndef PhysicsTableCache_h
+#define PhysicsTableCache_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+class G4VUserPhysicsList;
+
+// Caché de tablas físicas en disco. Tras /run/initialize calcula una clave
+// a partir de la lista de física, los materiales y los cortes; si existe un
+// directorio con esa clave, las tablas se recuperan en lugar de construirse.
+// Si no existe, se guardan después de la primera construcción.
+class PhysicsTableCache : public G4VStateDependent {
+public:
+    PhysicsTableCache(G4VUserPhysicsList* physicsList, const G4String& physicsName,
+                      const G4String& baseDirectory);
+    ~PhysicsTableCache() override = default;
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+private:
+    // Descripción textual de todo lo que determina las tablas
+    G4String BuildKey() const;
+
+    G4VUserPhysicsList* fPhysicsList;
+    G4String fPhysicsName;
+    G4String fBaseDirectory;
+    G4String fDirectory;   // directorio de la clave actual
+    G4String fKey;
+    G4int fInitPhases;     // fases Init completadas (0: initialize, 1: tablas)
+    G4bool fStore;         // guardar al terminar la construcción de tablas
+};
+
+#endif
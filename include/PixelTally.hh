@@ -0,0 +1,57 @@
+#ifndef PixelTally_h
+#define PixelTally_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// Conteos por píxel y banda de energía del detector segmentado
+// (/detector/pixels): una imagen del espectro transmitido en un solo run.
+//
+// Acumulable como FluxMesh: un arreglo plano indexado píxel·bandas + banda,
+// con el píxel iy·nx + ix tomado de los números de copia de las réplicas
+// (TransmittedSD). Los puntajes de cada evento pasan por un arreglo de
+// scratch para llevar las sumas de cuadrados (errores con pesos).
+class PixelTally : public G4VAccumulable {
+public:
+    static const G4String kName;   // nombre en el AccumulableManager
+
+    PixelTally();
+    ~PixelTally() override = default;
+
+    // Píxeles del run y número de bandas; sin píxeles (nx = 0) no se
+    // reserva memoria. Se llama al comienzo de cada run, antes del Reset.
+    void SetShape(G4int nx, G4int ny, G4int nBands);
+    G4bool IsEnabled() const { return !fSum.empty(); }
+
+    // --- Llenado (hilo dueño, EventAction) ---
+    void Add(G4int pixel, G4int band, G4double weight)
+    {
+        if (fSum.empty()) return;
+        std::size_t index = std::size_t(pixel)*fNumberOfBands + band;
+        if (fEvent[index] == 0.) fTouched.push_back(index);
+        fEvent[index] += weight;
+    }
+    void EndOfEvent();
+
+    // --- G4VAccumulable ---
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    // Neutrones por neutrón fuente y error relativo en float32 [banda, iy, ix]
+    // (<base>_pixels.bin, _pixels_err.bin) y su descripción en _pixels.json
+    void Write(const G4String& base, G4int nEvents, const std::vector<G4double>& edges,
+               G4double pitch) const;
+
+private:
+    G4int fN[2] = {0, 0};            // píxeles en x, y
+    G4int fNumberOfBands = 0;
+
+    std::vector<G4double> fSum;      // Σ peso por [píxel][banda]
+    std::vector<G4double> fSumSq;    // Σ (peso del evento)²
+    std::vector<G4double> fEvent;    // puntaje del evento actual
+    std::vector<std::size_t> fTouched;
+};
+
+#endif
@@ -3,15 +3,39 @@
 
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "G4ParticleGun.hh"
+#include "TabulatedSpectrum.hh"
+#include "EventSeeder.hh"
 
+class SourceMessenger;
+
+// Fuente de neutrones: por defecto el haz puntual monoenergético de /gun/.
+// Con /source/ la energía y cos θ se muestrean de espectros tabulados
+// (tablas de alias, tiempo constante por muestra) y la posición de un
+// disco; /gun/position y /gun/direction siguen siendo el centro y el eje.
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
   public:
     PrimaryGeneratorAction();
     ~PrimaryGeneratorAction() override;
     void GeneratePrimaries(G4Event* event) override;
 
+    // --- Configuración (comandos /source/) ---
+    void LoadEnergySpectrum(const G4String& fileName, G4double unit, G4bool linear);
+    void LoadAngularSpectrum(const G4String& fileName, G4bool linear);
+    void SetDisk(G4bool value) { fDisk = value; }
+    void SetRadius(G4double value) { fRadius = value; }
+    void SetConeAngle(G4double value);
+    void Reset();
+
   private:
     G4ParticleGun* fParticleGun;
+    SourceMessenger* fMessenger;
+    EventSeeder fSeeder;                 // semillas por evento (/seed/)
+
+    TabulatedSpectrum fEnergySpectrum;   // vacío: energía de /gun/energy
+    TabulatedSpectrum fAngularSpectrum;  // cos θ respecto del eje (vacío: cono)
+    G4bool fDisk;
+    G4double fRadius;
+    G4double fCosCone;                   // coseno del semiángulo (1: haz)
 };
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef ProfileRun_h
+#define ProfileRun_h 1
+
+#include "G4Run.hh"
+#include "globals.hh"
+
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+// Run con los contadores del perfil de pasos (opción --profile): pasos,
+// trazas y tiempo por combinación (volumen lógico, partícula, proceso).
+//
+// Durante el run cada hilo acumula en su propio ProfileRun con claves de
+// punteros (una búsqueda por paso). Al fusionar en el master las claves se
+// traducen a nombres, porque los procesos son objetos distintos en cada
+// hilo. En modo secuencial la traducción se hace al pedir la tabla.
+class ProfileRun : public G4Run {
+public:
+    struct Counters {
+        G4double steps = 0.;
+        G4double tracks = 0.;
+        G4double time = 0.;   // segundos (suma sobre todos los hilos)
+
+        Counters& operator+=(const Counters& other)
+        {
+            steps += other.steps;
+            tracks += other.tracks;
+            time += other.time;
+            return *this;
+        }
+    };
+
+    // (volumen, partícula, proceso) por nombre
+    using NameKey = std::tuple<G4String, G4String, G4String>;
+    using Table = std::map<NameKey, Counters>;
+
+    ProfileRun() = default;
+    ~ProfileRun() override = default;
+
+    void Merge(const G4Run* run) override;
+
+    // --- Llenado (hilo dueño del run) ---
+    // Paso en el volumen dado, limitado por el proceso dado
+    void AddStep(const G4LogicalVolume* volume, const G4ParticleDefinition* particle,
+                 const G4VProcess* process, G4double seconds)
+    {
+        Counters& counters = fCounters[{volume, particle, process}];
+        counters.steps += 1.;
+        counters.time += seconds;
+    }
+    // Traza nueva: volumen inicial y proceso creador (nullptr: primario)
+    void AddTrack(const G4LogicalVolume* volume, const G4ParticleDefinition* particle,
+                  const G4VProcess* creator)
+    {
+        fCounters[{volume, particle, creator}].tracks += 1.;
+    }
+
+    // Contadores fusionados por nombre (válido en el master al final del run)
+    Table GetTable() const;
+    G4bool IsEmpty() const { return fCounters.empty() && fMerged.empty(); }
+
+    // Tabla ordenada por tiempo, proyectada sobre volumen (0), partícula (1)
+    // o proceso (2); y tabla completa en CSV
+    void Print(G4int maxRows = 10) const;
+    void Write(const G4String& fileName) const;
+
+private:
+    struct PointerKey {
+        const G4LogicalVolume* volume;
+        const G4ParticleDefinition* particle;
+        const G4VProcess* process;
+
+        G4bool operator==(const PointerKey& other) const
+        {
+            return volume == other.volume && particle == other.particle && process == other.process;
+        }
+    };
+    struct PointerHash {
+        std::size_t operator()(const PointerKey& key) const
+        {
+            std::hash<const void*> h;
+            return h(key.volume) ^ (h(key.particle) << 1) ^ (h(key.process) << 2);
+        }
+    };
+
+    static NameKey Names(const PointerKey& key);
+    void PrintProjection(const Table& table, G4int column, G4int maxRows) const;
+
+    std::unordered_map<PointerKey, Counters, PointerHash> fCounters;  // de este hilo
+    Table fMerged;                                                     // de los hilos
+};
+
+#endif
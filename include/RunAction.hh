@@ -2,18 +2,152 @@
 #define RunAction_h 1
 
 #include "G4UserRunAction.hh"
+#include "G4Accumulable.hh"
+#include "G4Timer.hh"
+#include "G4ClassificationOfNewTrack.hh"
+#include "StackingRules.hh"
+#include "FluxMesh.hh"
+#include "ThermalizationTally.hh"
+#include "PixelTally.hh"
+#include "DepthPlanes.hh"
 #include "globals.hh"
 
+#include <vector>
+
 class G4Run;
+class RunMessenger;
+class ColumnarWriter;
+class CollisionRecorder;
 
 class RunAction : public G4UserRunAction
 {
 public:
+  // Número máximo de bandas de energía (límite de /tally/bands)
+  static constexpr G4int kMaxBands = 16;
+
+  // IDs de los histogramas (orden de creación; ver /analysis/h1|h2/...)
+  enum { kEnergyH1 = 0, kLogEnergyH1 = 1 };
+  enum { kEnergyTimeH2 = 0, kEnergyRadiusH2 = 1 };
+
   RunAction();
   virtual ~RunAction();
 
+  // ProfileRun: contadores del perfil de pasos (vacíos sin --profile)
+  virtual G4Run* GenerateRun();
   virtual void BeginOfRunAction(const G4Run*);
   virtual void EndOfRunAction(const G4Run*);
+
+  // Banda de energía de un neutrón transmitido
+  G4int GetBand(G4double kineticEnergy) const;
+  // Puntaje de un evento (llamado por EventAction): suma de pesos por banda
+  // (kMaxBands valores) y total. Se acumulan también los cuadrados para
+  // estimar el error con pesos (muestreo por importancia).
+  void AddEventScore(const G4double* bandWeight, G4double detectedWeight);
+  // Neutrón detectado en un píxel (/detector/pixels); las sumas de
+  // cuadrados se cierran en AddEventScore
+  void AddPixelScore(G4int pixel, G4int band, G4double weight) { fPixels.Add(pixel, band, weight); }
+
+  // --- Contadores de la StackingAction (por categoría de secundario) ---
+  void CountSecondary(G4int category, G4ClassificationOfNewTrack classification);
+  void CountDropped(G4int n) { fDropped += n; }
+  G4double GetSecondaries(G4int category) const { return fSecondaries[category].GetValue(); }
+  G4double GetKilled(G4int category) const      { return fKilled[category].GetValue(); }
+  G4double GetDeferred(G4int category) const    { return fDeferred[category].GetValue(); }
+  G4double GetDropped() const                   { return fDropped.GetValue(); }
+
+  // --- Contadores de TerminationAction (neutrones eliminados por corte) ---
+  void CountTerminated(G4int cut) { fTerminated[cut] += 1.; }
+  G4double GetTerminated(G4int cut) const { return fTerminated[cut].GetValue(); }
+
+  // --- Configuración (comandos /tally/ y /output/) ---
+  // Límites entre bandas en orden creciente: N límites definen N+1 bandas
+  G4bool SetBandEdges(const std::vector<G4double>& edges);
+  void SetNtupleEnabled(G4bool value) { fNtupleEnabled = value; }
+  void SetFileName(const G4String& name) { fFileName = name; }
+  // Formato de la ntuple: ROOT (G4AnalysisManager) o columnar (ColumnarWriter)
+  void SetColumnarOutput(G4bool value) { fColumnarOutput = value; }
+  // Bloques de la salida columnar (y de /collisions/) comprimidos con zlib
+  void SetCompression(G4bool value);
+  // Tiempos de termalización en el bloque (activos por defecto)
+  void SetThermalizationEnabled(G4bool value) { fThermalization.SetEnabled(value); }
+
+  G4bool IsNtupleEnabled() const { return fNtupleEnabled; }
+  // Escritor columnar del hilo, o nullptr si la salida columnar no está activa
+  ColumnarWriter* GetColumnarWriter() const;
+  // Historias de colisiones del hilo (/collisions/; activas si IsRecording())
+  CollisionRecorder* GetCollisionRecorder() const { return fCollisions; }
+  const std::vector<G4double>& GetBandEdges() const { return fBandEdges; }
+
+  // Conteos fusionados del último run (válidos en el master al final del run)
+  // (sumas de pesos: con muestreo analógico, número de neutrones)
+  G4double GetDetected() const { return fDetected.GetValue(); }
+  G4double GetDetectedError() const;
+  G4int GetNumberOfBands() const { return G4int(fBandEdges.size()) + 1; }
+  G4double GetBandCount(G4int band) const { return fBands[band].GetValue(); }
+  G4double GetBandError(G4int band) const;
+  G4String GetBandLabel(G4int band) const;
+  G4int GetNumberOfEvents() const { return fNumberOfEvents; }
+  G4double GetRunTime() const { return fTimer.GetRealElapsed(); }
+  // Figura de mérito 1/(R²·T) de una banda (R: error relativo, T: tiempo real del run)
+  G4double GetFigureOfMerit(G4int band) const;
+  const G4String& GetFileName() const { return fFileName; }
+
+  // Sumas por evento de un run, o de varios runs encadenados (RunDriver):
+  // las sumas y sumas de cuadrados de runs independientes se suman
+  struct Tallies {
+    G4int events = 0;
+    G4double time = 0.;
+    G4double detected = 0.;
+    G4double detectedSq = 0.;
+    std::vector<G4double> bands;     // GetNumberOfBands() elementos
+    std::vector<G4double> bandsSq;
+
+    void Add(const Tallies& other);
+  };
+  Tallies GetTallies() const;
+  // Conteos, errores y FOM de las sumas dadas (formato <archivo>_tallies.csv)
+  void WriteTallies(const Tallies& tallies, const G4String& fileName) const;
+
+private:
+  void PrintStackCounters() const;
+  void PrintTerminationCounters() const;
+
+  G4Timer fTimer; // Cronómetro del run (sólo se reporta en el master)
+  RunMessenger* fMessenger;
+
+  G4bool fNtupleEnabled = false;   // ntuple por neutrón (opcional)
+  G4bool fColumnarOutput = false;  // ntuple en <fileName>_cols/ en vez de ROOT
+  G4String fFileName = "NeutronData";
+  ColumnarWriter* fColumnar;
+  CollisionRecorder* fCollisions;  // en <fileName>_collisions/ (/collisions/enable)
+
+  // Conteos por banda de energía (locales a cada hilo, fusionados al final).
+  // fBands tiene siempre kMaxBands elementos: el AccumulableManager guarda
+  // referencias, así que el vector no debe cambiar de tamaño.
+  std::vector<G4double> fBandEdges;
+  G4Accumulable<G4double> fDetected;
+  G4Accumulable<G4double> fDetectedSq;              // suma de cuadrados por evento
+  std::vector<G4Accumulable<G4double>> fBands;
+  std::vector<G4Accumulable<G4double>> fBandsSq;
+  G4int fNumberOfEvents = 0;
+
+  // Secundarios vistos, eliminados y diferidos por la StackingAction
+  std::vector<G4Accumulable<G4double>> fSecondaries;
+  std::vector<G4Accumulable<G4double>> fKilled;
+  std::vector<G4Accumulable<G4double>> fDeferred;
+  G4Accumulable<G4double> fDropped;   // diferidos descartados (/stack/dropDeferred)
+
+  // Neutrones eliminados por TerminationAction, por corte (/cuts/)
+  std::vector<G4Accumulable<G4double>> fTerminated;
+
+  // Flujo por longitud de traza en el bloque (/flux/; lo llena FluxSD)
+  FluxMesh fFluxMesh;
+  // Energía vs tiempo desde el nacimiento en cada colisión en el bloque
+  ThermalizationTally fThermalization;
+  // Conteos por píxel y banda del detector segmentado (vacío sin píxeles)
+  PixelTally fPixels;
+  // Cruces hacia adelante de planos a varias profundidades (/planes/; FluxSD)
+  DepthPlanes fPlanes;
 };
 
 #endif
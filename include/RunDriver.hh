@@ -0,0 +1,58 @@
+#ifndef RunDriver_h
+#define RunDriver_h 1
+
+#include "RunAction.hh"
+#include "globals.hh"
+
+class RunDriverMessenger;
+class Convergence;
+
+// Runs largos divididos en tramos con puntos de control.
+//
+// /driver/beamOn N corre N eventos en tramos de /driver/checkpointEvery
+// eventos (un /run/beamOn por tramo). Cada tramo escribe su propia salida
+// (<archivo>_partNNNN.root, _cols/, ...), así que la memoria no crece con
+// el run y los tramos terminados quedan en disco. Después de cada tramo se
+// guarda un punto de control: eventos hechos, sumas de los conteos por
+// banda y el estado del generador aleatorio del master (que siembra los
+// eventos de los hilos). /driver/resume continúa desde el último punto de
+// control con la misma secuencia aleatoria que el run sin interrumpir. El
+// punto de control guarda también el ID del próximo run, que entra en las
+// semillas por evento (/seed/perEvent), y la continuación lo restablece.
+//
+// Con /convergence/ activo N es un máximo: los tramos se acortan a los
+// lotes que pide Convergence y el run termina al llegar al error objetivo
+// o al presupuesto de tiempo.
+class RunDriver {
+public:
+    RunDriver(Convergence* convergence);
+    ~RunDriver();
+
+    void SetCheckpointEvery(G4int events) { fEvery = events; }
+    void SetCheckpointFile(const G4String& name) { fCheckpointFile = name; }
+
+    void BeamOn(G4int nEvents);
+    void Resume();
+
+private:
+    void Continue();
+    void WriteCheckpoint() const;
+    G4bool ReadCheckpoint();
+    G4String PartName(G4int chunk) const;
+
+    RunDriverMessenger* fMessenger;
+    Convergence* fConvergence;
+
+    G4int fEvery;                 // eventos por tramo
+    G4String fCheckpointFile;     // <nombre>.chk y <nombre>.rndm
+
+    // Estado del run en curso (lo que se guarda en el punto de control)
+    G4String fBaseName;           // nombre base de la salida (/output/fileName)
+    G4int fTotal;                 // eventos pedidos
+    G4int fChunk;                 // tramos terminados
+    G4int fNextRunID;             // ID de run del próximo tramo (-1: desconocido)
+    std::vector<G4double> fEdges; // límites de banda con los que se empezó
+    RunAction::Tallies fTallies;  // sumas de los tramos terminados
+};
+
+#endif
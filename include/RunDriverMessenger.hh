@@ -0,0 +1,30 @@
+#ifndef RunDriverMessenger_h
+#define RunDriverMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class RunDriver;
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+
+class RunDriverMessenger : public G4UImessenger {
+public:
+    RunDriverMessenger(RunDriver* driver);
+    ~RunDriverMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    RunDriver* fDriver;
+
+    G4UIdirectory* fDriverDir;  // carpeta /driver/
+    G4UIcmdWithAnInteger* fEveryCmd;
+    G4UIcmdWithAString* fFileCmd;
+    G4UIcmdWithAnInteger* fBeamOnCmd;
+    G4UIcmdWithoutParameter* fResumeCmd;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef RunMessenger_h
+#define RunMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class RunAction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+
+// Comandos /tally/ y /output/ de RunAction. Cada hilo tiene su RunAction
+// (y su messenger); los comandos se reenvían a los hilos de trabajo.
+class RunMessenger : public G4UImessenger {
+public:
+    RunMessenger(RunAction* runAction);
+    ~RunMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    RunAction* fRunAction;
+
+    G4UIdirectory* fTallyDir;   // carpeta /tally/
+    G4UIcmdWithAString* fBandsCmd;
+    G4UIcmdWithABool* fThermalizationCmd;
+
+    G4UIdirectory* fOutputDir;  // carpeta /output/
+    G4UIcmdWithABool* fNtupleCmd;
+    G4UIcmdWithAString* fFileNameCmd;
+    G4UIcmdWithAString* fFormatCmd;
+    G4UIcmdWithABool* fCompressCmd;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SeedMessenger_h
+#define SeedMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class EventSeeder;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+
+// Comandos /seed/ de EventSeeder. Cada hilo tiene su generador primario
+// (y su EventSeeder); los comandos se reenvían a los hilos de trabajo.
+class SeedMessenger : public G4UImessenger {
+public:
+    SeedMessenger(EventSeeder* seeder);
+    ~SeedMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    EventSeeder* fSeeder;
+
+    G4UIdirectory* fSeedDir;   // carpeta /seed/
+    G4UIcmdWithABool* fPerEventCmd;
+    G4UIcommand* fMasterCmd;
+    G4UIcommand* fOffsetCmd;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SourceMessenger_h
+#define SourceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+// Comandos /source/ de PrimaryGeneratorAction. Cada hilo tiene su
+// generador (y su tabla de alias); los comandos se reenvían a los hilos.
+class SourceMessenger : public G4UImessenger {
+public:
+    SourceMessenger(PrimaryGeneratorAction* generator);
+    ~SourceMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    PrimaryGeneratorAction* fGenerator;
+
+    G4UIdirectory* fSourceDir;  // carpeta /source/
+    G4UIcommand* fSpectrumCmd;
+    G4UIcommand* fAngularCmd;
+    G4UIcmdWithAString* fShapeCmd;
+    G4UIcmdWithADoubleAndUnit* fRadiusCmd;
+    G4UIcmdWithADoubleAndUnit* fConeCmd;
+    G4UIcmdWithoutParameter* fResetCmd;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "StackingRules.hh"
+#include "globals.hh"
+
+#include <unordered_map>
+
+class RunAction;
+
+// Elimina o difiere secundarios que no son neutrones según StackingRules.
+// Los primarios y los neutrones siempre se siguen. Los conteos por
+// categoría se acumulan en RunAction y se fusionan al final del run.
+class StackingAction : public G4UserStackingAction
+{
+public:
+    StackingAction(const StackingRules* rules, RunAction* runAction);
+    ~StackingAction() override = default;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+    void NewStage() override;
+
+private:
+    StackCategory GetCategory(const G4ParticleDefinition* particle);
+
+    const StackingRules* fRules;
+    RunAction* fRunAction;
+    const G4ParticleDefinition* fNeutron;
+
+    // Caché de categorías por definición de partícula (local al hilo)
+    std::unordered_map<const G4ParticleDefinition*, StackCategory> fCategories;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef StackingComparison_h
+#define StackingComparison_h 1
+
+#include "globals.hh"
+
+class StackingRules;
+
+// Compara un run que sigue todos los secundarios con uno que aplica las
+// reglas de /stack/, con el mismo número de eventos: tiempo, eventos/s,
+// secundarios seguidos y eliminados, y la diferencia de conteos por banda
+// (las reglas no deberían cambiar lo que llega al detector).
+class StackingComparison {
+public:
+    StackingComparison(StackingRules* rules);
+    ~StackingComparison() = default;
+
+    void Run(G4int nEvents, const G4String& outputFile = "stack_compare.csv");
+
+private:
+    StackingRules* fRules;
+};
+
+#endif
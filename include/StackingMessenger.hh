@@ -0,0 +1,32 @@
+#ifndef StackingMessenger_h
+#define StackingMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class StackingRules;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithoutParameter;
+
+class StackingMessenger : public G4UImessenger {
+public:
+    StackingMessenger(StackingRules* rules);
+    ~StackingMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    StackingRules* fRules;
+
+    G4UIdirectory* fStackDir;  // carpeta /stack/
+    G4UIcommand* fRuleCmd;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithABool* fDropDeferredCmd;
+    G4UIcmdWithoutParameter* fPrintCmd;
+    G4UIcmdWithAnInteger* fCompareCmd;
+};
+
+#endif
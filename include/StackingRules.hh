@@ -0,0 +1,63 @@
+#ifndef StackingRules_h
+#define StackingRules_h 1
+
+#include "G4ClassificationOfNewTrack.hh"
+#include "globals.hh"
+
+#include <cfloat>
+
+class StackingMessenger;
+class G4ParticleDefinition;
+
+// Categorías de secundarios que la StackingAction puede descartar. Los
+// neutrones nunca se tocan: son lo único que registra el detector.
+enum StackCategory {
+    kGammaStack = 0,
+    kElectronStack,
+    kPositronStack,
+    kProtonStack,      // protones de retroceso (dispersión n-p)
+    kIonStack,         // núcleos de retroceso y fragmentos
+    kOtherStack,
+    kNumStackCategories
+};
+
+// Reglas de la StackingAction por categoría: mantener, eliminar o diferir
+// los secundarios con energía menor que un umbral.
+//
+// Un único objeto en el master (dueño: ActionInitialization), configurado
+// con /stack/ entre runs; las StackingAction de los hilos sólo lo leen.
+class StackingRules {
+public:
+    StackingRules();
+    ~StackingRules();
+
+    // action: fUrgent (mantener), fKill o fWaiting (diferir)
+    void SetRule(StackCategory category, G4ClassificationOfNewTrack action,
+                 G4double maxEnergy = DBL_MAX);
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    void SetDropDeferred(G4bool value) { fDropDeferred = value; }
+
+    // Clasificación de un secundario de la categoría dada
+    G4ClassificationOfNewTrack Classify(StackCategory category, G4double kineticEnergy) const
+    {
+        if (!fEnabled || kineticEnergy >= fMaxEnergy[category]) return fUrgent;
+        return fAction[category];
+    }
+
+    G4bool IsEnabled() const { return fEnabled; }
+    G4bool GetDropDeferred() const { return fDropDeferred; }
+    void Print() const;
+
+    static StackCategory GetCategory(const G4ParticleDefinition* particle);
+    static G4String GetCategoryName(G4int category);
+
+private:
+    StackingMessenger* fMessenger;
+
+    G4bool fEnabled;
+    G4bool fDropDeferred;   // los diferidos se descartan al vaciarse la pila urgente
+    G4ClassificationOfNewTrack fAction[kNumStackCategories];
+    G4double fMaxEnergy[kNumStackCategories];
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef StartupProfiler_h
+#define StartupProfiler_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+
+class DetectorConstruction;
+
+// Mide el tiempo de arranque por fase a partir de los cambios de estado de
+// Geant4: geometría, construcción de la física (/run/initialize), tablas
+// físicas + datos HP (primer RunInitialization) y primer evento.
+class StartupProfiler : public G4VStateDependent {
+public:
+    StartupProfiler(const DetectorConstruction* detector);
+    ~StartupProfiler() override = default;
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+    // Llamado desde EventAction (cualquier hilo) al terminar cada evento
+    static void MarkEventEnd();
+
+    void Print() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static G4double Seconds(Clock::time_point from, Clock::time_point to);
+
+    const DetectorConstruction* fDetector;
+
+    Clock::time_point fStart;          // inicio del programa
+    Clock::time_point fInitStart;      // última entrada al estado Init
+    Clock::time_point fRunStart;       // último inicio de run (GeomClosed)
+    G4double fInitialize;              // duración de /run/initialize
+    G4double fTables;                  // duración de la primera construcción de tablas
+    G4int fInitPhases;                 // número de fases Init completadas
+    G4bool fPrinted;
+
+    static std::atomic<G4bool> fFirstEventDone;
+    static Clock::time_point fFirstEventEnd;
+};
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef StepLimitComparison_h
+#define StepLimitComparison_h 1
+
+#include "globals.hh"
+
+class DetectorConstruction;
+
+// Modo de comparación de políticas de límite de paso: corre el mismo número
+// de eventos con cada política (aplicada a todos los volúmenes) y reporta
+// eventos/s y el espectro transmitido por bandas frente a "fixed".
+class StepLimitComparison {
+public:
+    StepLimitComparison(DetectorConstruction* detector);
+    ~StepLimitComparison() = default;
+
+    void Run(G4int nEvents, const G4String& outputFile = "step_limit_compare.csv");
+
+private:
+    DetectorConstruction* fDetector;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef StepProfiler_h
+#define StepProfiler_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+#include <chrono>
+
+class ProfileRun;
+
+// Perfil de pasos (opción --profile). Cada paso suma al ProfileRun del hilo
+// el tiempo transcurrido desde el paso anterior de la misma traza (o desde
+// el inicio de la traza), con su volumen lógico, partícula y proceso.
+// El tiempo entre trazas (pilas, SD, fin de evento) no se asigna a ningún
+// paso.
+class StepProfiler : public G4UserSteppingAction
+{
+public:
+    StepProfiler() = default;
+    ~StepProfiler() override = default;
+
+    void UserSteppingAction(const G4Step* step) override;
+
+    // Llamado por ProfileTrackingAction al empezar cada traza
+    void StartTrack(const G4Track* track);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ProfileRun* fRun = nullptr;
+    Clock::time_point fLast;
+};
+
+// Marca el inicio de cada traza para el StepProfiler
+class ProfileTrackingAction : public G4UserTrackingAction
+{
+public:
+    ProfileTrackingAction(StepProfiler* profiler) : fProfiler(profiler) {}
+    ~ProfileTrackingAction() override = default;
+
+    void PreUserTrackingAction(const G4Track* track) override { fProfiler->StartTrack(track); }
+
+private:
+    StepProfiler* fProfiler;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SweepMessenger_h
+#define SweepMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class GeometrySweep;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class SweepMessenger : public G4UImessenger {
+public:
+    SweepMessenger(GeometrySweep* sweep);
+    ~SweepMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    GeometrySweep* fSweep;
+
+    G4UIdirectory* fSweepDir;  // carpeta /detector/sweep/
+    G4UIcommand* fRangeCmd[3];
+    G4UIcmdWithAString* fFileCmd;
+    G4UIcmdWithAnInteger* fEventsCmd;
+    G4UIcmdWithAString* fOutputCmd;
+    G4UIcmdWithADoubleAndUnit* fGunOffsetCmd;
+    G4UIcmdWithoutParameter* fRunCmd;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TabulatedSpectrum_h
+#define TabulatedSpectrum_h 1
+
+#include "AliasTable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// Distribución continua tabulada (espectro de energía o de cos θ) leída
+// de un archivo de dos columnas "x  peso":
+//   hist: peso del intervalo [x_i, x_i+1) (el último peso no se usa);
+//   lin:  densidad en x_i, interpolada linealmente entre puntos.
+// El intervalo se elige con una tabla de alias y el valor dentro del
+// intervalo se invierte en forma cerrada, así que cada muestra cuesta lo
+// mismo sin importar el número de puntos.
+class TabulatedSpectrum {
+public:
+    enum Interpolation { kHistogram, kLinear };
+
+    TabulatedSpectrum() = default;
+
+    // x se multiplica por unit (p. ej. MeV). Devuelve false si el archivo
+    // no existe o no tiene al menos dos puntos crecientes.
+    G4bool Load(const G4String& fileName, G4double unit, Interpolation interpolation);
+    void Clear();
+
+    G4bool IsEmpty() const { return fTable.IsEmpty(); }
+    G4double GetMin() const { return fX.empty() ? 0. : fX.front(); }
+    G4double GetMax() const { return fX.empty() ? 0. : fX.back(); }
+    G4double GetMean() const { return fMean; }
+
+    // u1, u2 uniformes en [0,1)
+    G4double Sample(G4double u1, G4double u2) const;
+
+private:
+    std::vector<G4double> fX;        // puntos (límites de intervalo)
+    std::vector<G4double> fY;        // peso o densidad en cada punto
+    Interpolation fInterpolation = kHistogram;
+    AliasTable fTable;               // un elemento por intervalo
+    G4double fMean = 0.;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef TerminationAction_h
+#define TerminationAction_h 1
+
+#include "G4UserSteppingAction.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class TerminationCuts;
+class RunAction;
+class StepProfiler;
+class DetectorConstruction;
+class G4ParticleDefinition;
+class G4VSensitiveDetector;
+class G4Step;
+
+// Aplica los cortes de TerminationCuts al final de cada paso de un
+// neutrón y cuenta en RunAction los neutrones eliminados por cada corte.
+// Sin cortes activos sólo cuesta una comparación por paso.
+//
+// Geant4 admite una sola acción de paso por hilo: con --profile esta
+// acción es dueña del StepProfiler y lo llama después de los cortes.
+class TerminationAction : public G4UserSteppingAction
+{
+public:
+    TerminationAction(const TerminationCuts* cuts, RunAction* runAction,
+                      StepProfiler* profiler = nullptr);
+    ~TerminationAction() override;
+
+    void UserSteppingAction(const G4Step* step) override;
+
+private:
+    // Corte que elimina al neutrón en este paso, o -1
+    G4int Check(const G4Step* step);
+    // La línea recta desde p en dirección d cruza el bloque o el detector
+    G4bool InAcceptance(const G4ThreeVector& p, const G4ThreeVector& d) const;
+
+    const TerminationCuts* fCuts;
+    RunAction* fRunAction;
+    StepProfiler* fProfiler;
+    const DetectorConstruction* fDetector;
+    const G4ParticleDefinition* fNeutron;
+    G4VSensitiveDetector* fScoringSD = nullptr;   // TransmittedSD del hilo
+};
+
+#endif
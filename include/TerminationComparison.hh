@@ -0,0 +1,23 @@
+#ifndef TerminationComparison_h
+#define TerminationComparison_h 1
+
+#include "globals.hh"
+
+class TerminationCuts;
+
+// Compara un run sin cortes de terminación con uno con los cortes de
+// /cuts/, con el mismo número de eventos: tiempo, eventos/s, neutrones
+// eliminados por corte y la diferencia de conteos por banda (un corte que
+// no sesga deja los conteos dentro de su error).
+class TerminationComparison {
+public:
+    TerminationComparison(TerminationCuts* cuts);
+    ~TerminationComparison() = default;
+
+    void Run(G4int nEvents, const G4String& outputFile = "cuts_compare.csv");
+
+private:
+    TerminationCuts* fCuts;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TerminationCuts_h
+#define TerminationCuts_h 1
+
+#include "globals.hh"
+
+#include <cfloat>
+
+class TerminationMessenger;
+
+// Cortes que terminan neutrones (TerminationAction), cada uno con su
+// contador de neutrones eliminados en RunAction
+enum TerminationCut {
+    kScoredCut = 0,    // ya registrado por el detector
+    kEnergyCut,        // energía por debajo del piso
+    kTimeCut,          // tiempo global mayor que el límite
+    kAcceptanceCut,    // en el aire, sin camino recto al detector ni al bloque
+    kNumTerminationCuts
+};
+
+// Cortes de terminación de neutrones. Por defecto no hay ninguno activo:
+// los neutrones se siguen hasta capturarse o salir del mundo.
+//
+// Como StackingRules, un único objeto en el master (dueño:
+// ActionInitialization), configurado con /cuts/ entre runs; las
+// TerminationAction de los hilos sólo lo leen.
+class TerminationCuts {
+public:
+    TerminationCuts();
+    ~TerminationCuts();
+
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    void SetKillScored(G4bool value) { fKillScored = value; }
+    // 0 desactiva el piso de energía; DBL_MAX, el límite de tiempo
+    void SetMinEnergy(G4double value) { fMinEnergy = value; }
+    void SetMaxTime(G4double value) { fMaxTime = value; }
+    // Margen alrededor del detector para la aceptancia (negativo: sin corte)
+    void SetAcceptanceMargin(G4double value) { fAcceptanceMargin = value; }
+
+    G4bool IsEnabled() const { return fEnabled; }
+    G4bool GetKillScored() const { return fEnabled && fKillScored; }
+    G4double GetMinEnergy() const { return fEnabled ? fMinEnergy : 0.; }
+    G4double GetMaxTime() const { return fEnabled ? fMaxTime : DBL_MAX; }
+    G4bool HasAcceptance() const { return fEnabled && fAcceptanceMargin >= 0.; }
+    G4double GetAcceptanceMargin() const { return fAcceptanceMargin; }
+    // Algún corte activo (si no, TerminationAction no mira los pasos)
+    G4bool IsActive() const;
+
+    void Print() const;
+    static G4String GetCutName(G4int cut);
+
+private:
+    TerminationMessenger* fMessenger;
+
+    G4bool fEnabled = true;
+    G4bool fKillScored = false;
+    G4double fMinEnergy = 0.;
+    G4double fMaxTime = DBL_MAX;
+    G4double fAcceptanceMargin = -1.;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef TerminationMessenger_h
+#define TerminationMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class TerminationCuts;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class TerminationMessenger : public G4UImessenger {
+public:
+    TerminationMessenger(TerminationCuts* cuts);
+    ~TerminationMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+private:
+    TerminationCuts* fCuts;
+
+    G4UIdirectory* fCutsDir;  // carpeta /cuts/
+    G4UIcmdWithABool* fKillScoredCmd;
+    G4UIcmdWithADoubleAndUnit* fMinEnergyCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxTimeCmd;
+    G4UIcmdWithADoubleAndUnit* fAcceptanceCmd;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithoutParameter* fPrintCmd;
+    G4UIcmdWithAnInteger* fCompareCmd;
+};
+
+#endif
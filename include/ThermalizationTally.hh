@@ -0,0 +1,70 @@
+#ifndef ThermalizationTally_h
+#define ThermalizationTally_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// Termalización en el bloque: en cada colisión hadrónica de un neutrón
+// dentro del bloque que lo deja vivo (FluxSD; las capturas no) se llena
+// un mapa energía vs tiempo desde el nacimiento del neutrón, con bines
+// logarítmicos fijos, y se anota la primera vez que el neutrón baja de
+// cada límite de banda (/tally/bands) para dar el tiempo medio hasta
+// cada banda.
+//
+// Como FluxMesh, es un acumulable: cada hilo llena sus propios arreglos
+// sin bloqueos y el AccumulableManager los suma una vez al final del run.
+class ThermalizationTally : public G4VAccumulable {
+public:
+    static const G4String kName;   // nombre en el AccumulableManager
+
+    // Bines fijos: 10 por década en energía (1 meV a 10 MeV) y en tiempo
+    // (0.1 ns a 10 ms)
+    static constexpr G4int kEnergyBins = 100;
+    static constexpr G4int kTimeBins = 80;
+    static constexpr G4int kMaxEdges = 16;
+
+    ThermalizationTally();
+    ~ThermalizationTally() override = default;
+
+    void SetEnabled(G4bool value) { fEnabled = value; }
+    G4bool IsEnabled() const { return fEnabled; }
+    // Límites de banda del run (los de RunAction, en orden creciente)
+    void SetBandEdges(const std::vector<G4double>& edges);
+
+    // --- Llenado (hilo dueño) ---
+    // Colisión de un neutrón: energía después de la colisión, tiempo desde
+    // su nacimiento, peso y energía con la que nació la traza
+    void AddCollision(G4int trackID, G4double kineticEnergy, G4double localTime,
+                      G4double weight, G4double vertexEnergy);
+    void EndOfEvent() { fTrackID = -1; }
+
+    // --- G4VAccumulable ---
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    // --- Resultados (master, al final del run) ---
+    void Print(G4int nEvents) const;
+    // Tiempos por límite en <base>_thermalization.csv; mapa de colisiones por
+    // neutrón fuente en <base>_thermalization.bin (float32 [tiempo, energía])
+    // y su descripción en <base>_thermalization.json
+    void Write(const G4String& base, G4int nEvents) const;
+
+private:
+    G4int EdgeIndex(G4double kineticEnergy) const;
+
+    G4bool fEnabled = true;
+    std::vector<G4double> fEdges;
+
+    // Neutrón en curso: límites que ya cruzó (los de índice >= fReached)
+    G4int fTrackID = -1;
+    G4int fReached = 0;
+
+    std::vector<G4double> fMap;      // Σ peso por [tiempo][energía]
+    G4double fSumW[kMaxEdges];       // Σ peso de los neutrones que cruzaron
+    G4double fSumWT[kMaxEdges];      // Σ peso·t
+    G4double fSumWT2[kMaxEdges];     // Σ peso·t²
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TransmittedHit_h
+#define TransmittedHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+class G4VProcess;
+
+// Neutrón que entra al detector: estado en el punto de entrada.
+// El volumen y el proceso se guardan como punteros; los nombres sólo se
+// resuelven al volcar el hit a la ntuple (EventAction).
+class TransmittedHit : public G4VHit
+{
+public:
+  TransmittedHit() = default;
+  ~TransmittedHit() override = default;
+
+  // Memoria de un pool por hilo (G4Allocator) en vez de new/delete
+  inline void* operator new(size_t);
+  inline void  operator delete(void*);
+
+  void SetTrackID(G4int id)                   { fTrackID = id; }
+  void SetParentID(G4int id)                  { fParentID = id; }
+  void SetKineticEnergy(G4double e)           { fKineticEnergy = e; }
+  void SetGlobalTime(G4double t)              { fGlobalTime = t; }
+  void SetPosition(const G4ThreeVector& pos)  { fPosition = pos; }
+  void SetDirection(const G4ThreeVector& dir) { fDirection = dir; }
+  void SetTrackLength(G4double l)             { fTrackLength = l; }
+  void SetStepNumber(G4int n)                 { fStepNumber = n; }
+  void SetVolume(const G4VPhysicalVolume* v)  { fVolume = v; }
+  void SetProcess(const G4VProcess* p)        { fProcess = p; }
+  void SetWeight(G4double w)                  { fWeight = w; }
+  void SetPixel(G4int pixel)                  { fPixel = pixel; }
+
+  G4int GetTrackID() const                   { return fTrackID; }
+  G4int GetParentID() const                  { return fParentID; }
+  G4double GetKineticEnergy() const          { return fKineticEnergy; }
+  G4double GetGlobalTime() const             { return fGlobalTime; }
+  const G4ThreeVector& GetPosition() const   { return fPosition; }
+  const G4ThreeVector& GetDirection() const  { return fDirection; }
+  G4double GetTrackLength() const            { return fTrackLength; }
+  G4int GetStepNumber() const                { return fStepNumber; }
+  const G4VPhysicalVolume* GetVolume() const { return fVolume; }
+  const G4VProcess* GetProcess() const       { return fProcess; }
+  G4double GetWeight() const                 { return fWeight; }
+  G4int GetPixel() const                     { return fPixel; }
+
+private:
+  G4int fTrackID = -1;
+  G4int fParentID = -1;
+  G4double fKineticEnergy = 0.;
+  G4double fGlobalTime = 0.;
+  G4ThreeVector fPosition;
+  G4ThreeVector fDirection;
+  G4double fTrackLength = 0.;
+  G4int fStepNumber = 0;
+  const G4VPhysicalVolume* fVolume = nullptr;
+  const G4VProcess* fProcess = nullptr;
+  G4double fWeight = 1.;  // peso de la traza (muestreo por importancia)
+  G4int fPixel = 0;       // iy·nx + ix con /detector/pixels (0 sin píxeles)
+};
+
+using TransmittedHitsCollection = G4THitsCollection<TransmittedHit>;
+
+extern G4ThreadLocal G4Allocator<TransmittedHit>* TransmittedHitAllocator;
+
+inline void* TransmittedHit::operator new(size_t)
+{
+  if (!TransmittedHitAllocator) TransmittedHitAllocator = new G4Allocator<TransmittedHit>;
+  return (void*)TransmittedHitAllocator->MallocSingle();
+}
+
+inline void TransmittedHit::operator delete(void* hit)
+{
+  TransmittedHitAllocator->FreeSingle((TransmittedHit*)hit);
+}
+
+#endif
@@ -3,14 +3,35 @@
 
 #include "G4VSensitiveDetector.hh"
 #include "G4Step.hh"
-#include "G4THitsCollection.hh"
+#include "TransmittedHit.hh"
+
+class G4ParticleDefinition;
 
 class TransmittedSD : public G4VSensitiveDetector {
   public:
     TransmittedSD(const G4String& name);
     ~TransmittedSD() override;
+    void Initialize(G4HCofThisEvent*) override;
     G4bool ProcessHits(G4Step* aStep, G4TouchableHistory*) override;
     void EndOfEvent(G4HCofThisEvent*) override {}
+
+    // Nombre completo de la colección ("SD/colección") para EventAction
+    static const G4String kHitsCollectionName;
+
+    // Columnas de la matriz de píxeles (0: detector único). El SD va en los
+    // píxeles y el índice de un hit es iy·nx + ix (números de copia).
+    void SetPixelColumns(G4int nx) { fPixelColumns = nx; }
+
+  private:
+    TransmittedHitsCollection* fHitsCollection; // hits del evento actual
+    G4int fHCID;                                // ID de la colección (por hilo)
+    const G4ParticleDefinition* fNeutron;       // definición cacheada del neutrón
+    G4int fPixelColumns = 0;
+
+    // Último paso visto dentro del detector, para no contar como entrada
+    // el paso de un píxel al vecino
+    G4int fLastTrackID = -1;
+    G4int fLastStepNumber = 0;
 };
 
 #endif
@@ -0,0 +1,72 @@
+import json
+import os
+import struct
+import sys
+import zlib
+
+import numpy as np
+
+# --- Lectura de la ntuple columnar (/output/format columnar) ---
+# Cada columna es un archivo binario crudo descrito en schema.json, así que
+# se abre con np.memmap sin copiar ni convertir nada. Con /output/compress
+# la columna es una serie de bloques zlib (cabecera uint32 tamaño crudo,
+# uint32 tamaño comprimido) y se descomprime en memoria.
+#
+#   cols = load("NeutronData_cols")
+#   E = cols["KineticEnergy_eV"]              # np.memmap float32
+#   vol = labels("NeutronData_cols", "FinalVolume")
+
+
+def schema(directory):
+    with open(os.path.join(directory, "schema.json")) as f:
+        return json.load(f)
+
+
+def raw_blocks(path):
+    """Bloques descomprimidos de un archivo de columna comprimido."""
+    with open(path, "rb") as f:
+        while True:
+            header = f.read(8)
+            if len(header) < 8:
+                return
+            raw, size = struct.unpack("=II", header)
+            yield zlib.decompress(f.read(size))
+
+
+def load(directory):
+    """Devuelve {columna: np.memmap} para todas las columnas (np.ndarray si
+    están comprimidas)."""
+    s = schema(directory)
+    columns = {}
+    for col in s["columns"]:
+        if s["rows"] == 0:
+            columns[col["name"]] = np.empty(0, dtype=col["dtype"])
+            continue
+        if col.get("compression") == "zlib":
+            data = b"".join(raw_blocks(os.path.join(directory, col["file"])))
+            columns[col["name"]] = np.frombuffer(data, dtype=col["dtype"], count=s["rows"])
+            continue
+        columns[col["name"]] = np.memmap(os.path.join(directory, col["file"]),
+                                         dtype=col["dtype"], mode="r",
+                                         shape=(s["rows"],))
+    return columns
+
+
+def labels(directory, name):
+    """Decodifica una columna enumerada (volumen, proceso) a texto."""
+    s = schema(directory)
+    col = next(c for c in s["columns"] if c["name"] == name)
+    names = np.array(col["labels"] + ["<otros>"] * (256 - len(col["labels"])))
+    return names[load(directory)[name]]
+
+
+if __name__ == "__main__":
+    directory = sys.argv[1] if len(sys.argv) > 1 else "NeutronData_cols"
+    cols = load(directory)
+    E = cols["KineticEnergy_eV"]
+    n = len(E)
+    print(f"🔹 {n} neutrones transmitidos en '{directory}'")
+    if n:
+        print(f"   Térmicos    (< 0.025 eV): {np.count_nonzero(E < 0.025)}")
+        print(f"   Epitérmicos (< 0.5 eV):   {np.count_nonzero((E >= 0.025) & (E < 0.5))}")
+        print(f"   Rápidos     (>= 0.5 eV):  {np.count_nonzero(E >= 0.5)}")
@@ -0,0 +1,214 @@
+import json
+import math
+import os
+import re
+import sys
+
+import numpy as np
+
+# --- Lectura de la malla de flujo (/flux/enable true) ---
+# <nombre>_flux.json describe la forma [energía, z, y, x] y los bordes;
+# el flujo (1/cm² por neutrón fuente) y su error relativo son float32 crudos.
+#
+#   phi, err, info = load("NeutronData")
+#   phi[0, :, 5, 5]      # primera banda de energía a lo largo de z
+#   h, t, e = load_thermalization("NeutronData")   # /tally/thermalization
+#   img, err, info = load_pixels("NeutronData")    # /detector/pixels
+#   planes = load_planes("NeutronData")             # /planes/depths
+#
+# Cada tramo de /driver/beamOn (<nombre>_partNNNN) y cada shard de
+# shards.py (<nombre>_shardNNN) escribe sus propios archivos; combine()
+# los une en <nombre>_* (shards.py lo hace solo):
+#   python3 flux.py --combine NeutronData NeutronData_part*_flux.json
+
+
+def load(base):
+    with open(base + "_flux.json") as f:
+        info = json.load(f)
+    shape = tuple(info["shape"])
+    phi = np.fromfile(info["flux"], dtype=info["dtype"]).reshape(shape)
+    err = np.fromfile(info["error"], dtype=info["dtype"]).reshape(shape)
+    return phi, err, info
+
+
+def load_thermalization(base):
+    """Mapa de colisiones [tiempo, energía] y bordes log10 (t/ns, E/eV)."""
+    with open(base + "_thermalization.json") as f:
+        info = json.load(f)
+    nt, ne = info["shape"]
+    h = np.fromfile(info["map"], dtype=info["dtype"]).reshape((nt, ne))
+    t_edges = np.linspace(*info["log10_time_ns"], nt + 1)
+    e_edges = np.linspace(*info["log10_energy_eV"], ne + 1)
+    return h, t_edges, e_edges
+
+
+def load_pixels(base):
+    """Neutrones por neutrón fuente [banda, y, x] del detector segmentado y
+    su error relativo."""
+    with open(base + "_pixels.json") as f:
+        info = json.load(f)
+    shape = tuple(info["shape"])
+    img = np.fromfile(info["counts"], dtype=info["dtype"]).reshape(shape)
+    err = np.fromfile(info["error"], dtype=info["dtype"]).reshape(shape)
+    return img, err, info
+
+
+def load_planes(base):
+    """Tabla de los planos de profundidad: {banda: [(profundidad_cm,
+    por evento, error, fracción), ...]} en orden de profundidad."""
+    planes = {}
+    with open(base + "_planes.csv") as f:
+        for line in f:
+            if line.startswith(("#", "Profundidad")) or not line.strip():
+                continue
+            depth, band, n, error, fraction = line.strip().split(",")
+            planes.setdefault(band, []).append((float(depth), float(n), float(error), float(fraction)))
+    return planes
+
+
+# ------------------------------------------------------------
+# Unión de tramos o shards
+# ------------------------------------------------------------
+# Cada parte guarda valores por evento; con sus eventos N_i se vuelve a
+# las sumas. Los valores se promedian pesados por N_i y los errores
+# absolutos de las sumas se suman en cuadratura (partes independientes,
+# como los conteos de _tallies.csv).
+def combine_binary(parts, output, suffix, name, error_name=None):
+    """Une <parte>_<suffix>.json y sus .bin en <output>_<suffix>.*"""
+    infos = []
+    for part in parts:
+        if os.path.exists(f"{part}_{suffix}.json"):
+            with open(f"{part}_{suffix}.json") as f:
+                infos.append(json.load(f))
+    if not infos:
+        return
+    if any(info["shape"] != infos[0]["shape"] for info in infos):
+        print(f"⚠️ {output}_{suffix}: las partes tienen formas distintas, no se unen")
+        return
+
+    events = sum(info["events"] for info in infos)
+    total, var = 0., 0.
+    for info in infos:
+        value = np.fromfile(info[name], dtype=info["dtype"]).astype(np.float64) * info["events"]
+        total = total + value
+        if error_name:
+            error = np.fromfile(info[error_name], dtype=info["dtype"]).astype(np.float64)
+            var = var + (error * value) ** 2
+
+    merged = dict(infos[0], events=events)
+    merged[name] = f"{output}_{suffix}.bin"
+    (total / events).astype(merged["dtype"]).tofile(merged[name])
+    if error_name:
+        merged[error_name] = f"{output}_{suffix}_err.bin"
+        relative = np.divide(np.sqrt(var), total, out=np.zeros_like(total), where=total > 0)
+        relative.astype(merged["dtype"]).tofile(merged[error_name])
+    with open(f"{output}_{suffix}.json", "w") as f:
+        json.dump(merged, f, indent=2)
+    print(f"✅ {len(infos)} partes unidas en '{output}_{suffix}.bin'")
+
+
+def read_parts_csv(parts, suffix):
+    """(eventos, encabezado, filas) de cada <parte>_<suffix> que exista."""
+    tables = []
+    for part in parts:
+        if not os.path.exists(f"{part}_{suffix}"):
+            continue
+        events, rows = 0, []
+        with open(f"{part}_{suffix}") as f:
+            for line in f:
+                if line.startswith("# Eventos:"):
+                    events = int(line.split(":")[1])
+                elif line.strip() and not line.startswith("#"):
+                    rows.append(line.strip().split(","))
+        tables.append((events, rows[0], rows[1:]))
+    return tables
+
+
+def write_csv(path, events, header, rows):
+    with open(path, "w") as f:
+        f.write(f"# Eventos: {events}\n")
+        f.write(",".join(header) + "\n")
+        for row in rows:
+            f.write(",".join(str(x) for x in row) + "\n")
+    print(f"✅ Partes unidas en '{path}'")
+
+
+def combine_thermalization(parts, output):
+    """Tiempos hasta cada límite: se reconstruyen Σw, Σw·t y Σw·t² de cada parte."""
+    tables = read_parts_csv(parts, "thermalization.csv")
+    if not tables:
+        return
+    events = sum(n for n, _, _ in tables)
+    sums = {}
+    for n, _, rows in tables:
+        for limit, per_event, mean, sigma, _ in rows:
+            w = float(per_event) * n
+            s = sums.setdefault(limit, [0., 0., 0.])
+            s[0] += w
+            s[1] += w * float(mean)
+            s[2] += w * (float(sigma) ** 2 + float(mean) ** 2)
+    rows = []
+    for limit, (w, wt, wt2) in sums.items():
+        mean = wt / w if w > 0 else 0.
+        sigma = math.sqrt(max(0., wt2 / w - mean * mean)) if w > 0 else 0.
+        rows.append([limit, w / events, mean, sigma, sigma / math.sqrt(w) if w > 0 else 0.])
+    write_csv(f"{output}_thermalization.csv", events, tables[0][1], rows)
+
+
+def combine_planes(parts, output):
+    """Planos de profundidad (conteos por plano y banda) y sus espectros."""
+    tables = read_parts_csv(parts, "planes.csv")
+    if tables:
+        events = sum(n for n, _, _ in tables)
+        sums, planes = {}, {}
+        for n, _, rows in tables:
+            for depth, band, per_event, error, _ in rows:
+                s = sums.setdefault((depth, band), [0., 0.])
+                s[0] += float(per_event) * n
+                s[1] += (float(error) * n) ** 2
+                planes[depth] = planes.get(depth, 0.) + float(per_event) * n
+        rows = [[depth, band, total / events, math.sqrt(var) / events,
+                 total / planes[depth] if planes[depth] > 0 else 0.]
+                for (depth, band), (total, var) in sums.items()]
+        write_csv(f"{output}_planes.csv", events, tables[0][1], rows)
+
+    tables = read_parts_csv(parts, "planes_spectra.csv")
+    if tables:
+        events = sum(n for n, _, _ in tables)
+        sums = {}
+        for n, _, rows in tables:
+            for depth, emin, emax, per_event in rows:
+                sums[(depth, emin, emax)] = sums.get((depth, emin, emax), 0.) + float(per_event) * n
+        rows = [[*key, total / events] for key, total in sums.items()]
+        write_csv(f"{output}_planes_spectra.csv", events, tables[0][1], rows)
+
+
+def combine(parts, output):
+    """Une la malla de flujo, la termalización, los píxeles y los planos de
+    las partes (nombres base) en <output>_*; lo que una parte no tenga se
+    omite."""
+    combine_binary(parts, output, "flux", "flux", "error")
+    combine_binary(parts, output, "thermalization", "map")
+    combine_thermalization(parts, output)
+    combine_binary(parts, output, "pixels", "counts", "error")
+    combine_planes(parts, output)
+
+
+if __name__ == "__main__" and sys.argv[1:2] == ["--combine"]:
+    # Las partes se dan por nombre base o por cualquiera de sus archivos
+    suffix = r"(_(flux|thermalization|pixels|planes|tallies|cols)[^/]*|\.\w+)$"
+    parts = sorted({re.sub(suffix, "", arg) for arg in sys.argv[3:]})
+    combine(parts, sys.argv[2])
+elif __name__ == "__main__":
+    base = sys.argv[1] if len(sys.argv) > 1 else "NeutronData"
+    phi, err, info = load(base)
+    edges = info["energy_edges_eV"]
+    half_z = info["half_cm"][2]
+    nz = phi.shape[1]
+    print(f"🔹 Malla {phi.shape} de '{base}', {info['events']} eventos")
+    for e in range(phi.shape[0]):
+        profile = phi[e].mean(axis=(1, 2))
+        print(f"   {edges[e]:9.3g}-{edges[e + 1]:<9.3g} eV: flujo medio {phi[e].mean():.4g} 1/cm²")
+        for iz in range(0, nz, max(1, nz // 5)):
+            z = -half_z + (iz + 0.5) * 2 * half_z / nz
+            print(f"      z = {z:6.2f} cm: {profile[iz]:.4g}")
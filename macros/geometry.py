@@ -1,96 +1,65 @@
-import os
-import numpy as np
 import pandas as pd
-import uproot
 import subprocess
 import time
 
-# --- Parámetros del barrido ---
-X_values = np.arange(0.5, 10.1, 0.5)  # cm
-Y_values = np.arange(0.5, 10.1, 0.5)   # cm
-Z_values = np.arange(0.5, 10.1, 0.5)   # cm (espesor)
+# --- Parámetros del barrido (medias longitudes, en cm) ---
+X_range = (0.5, 10.0, 0.5)
+Y_range = (0.5, 10.0, 0.5)
+Z_range = (0.5, 10.0, 0.5)  # (espesor)
 
-start_time = time.time() 
+# Eventos por punto: con error objetivo es un máximo y cada punto termina
+# al llegar al error relativo pedido en la banda térmica (0 = siempre n_events)
+n_events = 1000000
+target_error = 0.01
+max_time_s = 0
+
+start_time = time.time()
 # --- Ruta del ejecutable ---
 exe = "./Neutron_Thermalization"
 
-# --- Archivo ROOT de salida ---
-root_file = "NeutronData.root"
-
-# --- Lista de resultados ---
-results = []
+# --- Tabla de resultados (la escribe el propio ejecutable) ---
+csv_file = "resultados_parafina.csv"
 
-for X in X_values:
-    for Y in Y_values:
-        for Z in Z_values:
-            # 1️⃣ Generar macro temporal
-            macro_content = f"""\
+# El barrido completo corre en un solo proceso: la física y los datos HP se
+# cargan una vez y la geometría se modifica en el lugar en cada punto.
+macro_content = f"""\
 /control/verbose 2
-/run/verbose 1
+/run/verbose 0
 /event/verbose 0
 /tracking/verbose 0
 
-/detector/setParaffinX {X} cm
-/detector/setParaffinY {Y} cm
-/detector/setParaffinZ {Z} cm
-
 /run/initialize
 
-# Configuración del haz
+# Configuración del haz (la posición la ajusta el barrido con el espesor)
 /gun/particle neutron
 /gun/energy 4.2 MeV
-/gun/position 0 0 -{Z+0.1} cm
 /gun/direction 0 0 1
 /gun/number 1
 
-# Simulación
-/run/beamOn 1000000
+# Barrido
+/detector/sweep/rangeX {X_range[0]} {X_range[1]} {X_range[2]} cm
+/detector/sweep/rangeY {Y_range[0]} {Y_range[1]} {Y_range[2]} cm
+/detector/sweep/rangeZ {Z_range[0]} {Z_range[1]} {Z_range[2]} cm
+/detector/sweep/gunOffset 0.1 cm
+/detector/sweep/events {n_events}
+/convergence/targetError {target_error}
+/convergence/tally 0
+/convergence/maxTime {max_time_s} s
+/detector/sweep/output {csv_file}
+/detector/sweep/run
 """
-            macro_file = "auto.mac"
-            with open(macro_file, "w") as f:
-                f.write(macro_content)
-
-            print(f"\n🔹 Simulando bloque {2*X}×{2*Y}×{2*Z} cm...")
-
-            # 2️⃣ Ejecutar Geant4
-            subprocess.run([exe, macro_file], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
-
-            # 3️⃣ Leer el archivo ROOT
-            if not os.path.exists(root_file):
-                print("⚠️ No se encontró el archivo ROOT.")
-                continue
-
-            try:
-                with uproot.open(root_file) as froot:
-                    tree = froot["NeutronTracks"]
-                    energy = tree["KineticEnergy_eV"].array(library="np")
-
-                total_detected = len(energy)
-                thermal = np.sum(energy < 0.025)         # E < 0.025 eV
-                epithermal = np.sum((energy >= 0.025) & (energy < 0.5))
-                fast = np.sum(energy >= 0.5)
-
-                results.append({
-                    "Ancho_(cm)": 2*X,
-                    "Alto_(cm)": 2*Y,
-                    "Espesor_(cm)": 2*Z,
-                    "Detectados": total_detected,
-                    "Termicos": int(thermal),
-                    "Epitermicos": int(epithermal),
-                    "Rapidos": int(fast)
-                })
-
-                # Guarda una copia del ROOT para esta geometría
-                new_root = f"NeutronData_{2*X}x{2*Y}x{2*Z}.root"
-                os.rename(root_file, new_root)
+macro_file = "sweep.mac"
+with open(macro_file, "w") as f:
+    f.write(macro_content)
 
-            except Exception as e:
-                print(f"❌ Error leyendo ROOT: {e}")
+print("🔹 Ejecutando el barrido completo en un solo proceso...")
+subprocess.run([exe, macro_file], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
 
-# --- 4️⃣ Guardar CSV final ---
-df = pd.DataFrame(results)
-df.to_csv("resultados_parafina.csv", index=False)
+df = pd.read_csv(csv_file)
 elapsed = time.time() - start_time
 mins, secs = divmod(elapsed, 60)
+print(df.tail())
+print(f"🔹 Eventos usados por punto: {df['Eventos'].min()}–{df['Eventos'].max()}"
+      f" (total {df['Eventos'].sum()}, máximo {n_events} por punto)")
 print(f"⏱️ Tiempo total de ejecución: {int(mins)} min {secs:.1f} s")
-print("\n✅ Resultados guardados en 'resultados_parafina.csv'")
+print(f"\n✅ {len(df)} configuraciones guardadas en '{csv_file}'")
@@ -0,0 +1,63 @@
+import re
+import subprocess
+import sys
+
+# --- Costo por hit del detector ---
+# Uso: python3 hitcost.py [eventos] ejecutable [ejecutable2 ...]
+#
+# Con un bloque de 1 mm casi todos los neutrones llegan al detector con
+# pocos pasos, así que el tiempo por evento está dominado por el manejo del
+# hit. Se corre en modo secuencial sin ntuple, con ntuple ROOT y con ntuple
+# columnar; para comparar antes/después se pasan los dos ejecutables.
+
+args = sys.argv[1:]
+n_events = int(args.pop(0)) if args and args[0].isdigit() else 200000
+executables = args or ["./Neutron_Thermalization"]
+
+modes = {
+    "sin_ntuple": "/output/ntuple false",
+    "root":       "/output/ntuple true\n/output/format root",
+    "columnar":   "/output/ntuple true\n/output/format columnar",
+}
+
+time_re = re.compile(r"Tiempo del run \(Wall\):\s+([0-9.eE+-]+)")
+hits_re = re.compile(r"Neutrones detectados:\s+([0-9.eE+-]+)")
+
+results = []
+for exe in executables:
+    for mode, commands in modes.items():
+        macro = f"""\
+/control/verbose 0
+/run/verbose 0
+/detector/setParaffinZ 0.05 cm
+/run/initialize
+/gun/particle neutron
+/gun/energy 4.2 MeV
+/gun/position 0 0 -0.15 cm
+/gun/direction 0 0 1
+{commands}
+/output/fileName hitcost
+/run/beamOn {n_events}
+"""
+        with open("hitcost.mac", "w") as f:
+            f.write(macro)
+
+        print(f"🔹 {exe} ({mode}), {n_events} eventos...")
+        out = subprocess.run([exe, "hitcost.mac", "-m", "serial"],
+                             capture_output=True, text=True).stdout
+        t, h = time_re.search(out), hits_re.search(out)
+        if not t or not h:
+            print("⚠️ No se encontró el tiempo o los conteos en la salida.")
+            continue
+        wall, hits = float(t.group(1)), float(h.group(1))
+        results.append((exe, mode, wall, hits))
+
+if results:
+    print("\n Ejecutable                      Modo          Eventos/s   Hits     µs/hit")
+    with open("hitcost.csv", "w") as f:
+        f.write("Ejecutable,Modo,Tiempo_s,Hits,us_por_hit\n")
+        for exe, mode, wall, hits in results:
+            per_hit = 1e6 * wall / hits if hits else 0.
+            print(f" {exe:31s} {mode:12s} {n_events / wall:10.0f} {hits:8.0f} {per_hit:9.3f}")
+            f.write(f"{exe},{mode},{wall},{hits},{per_hit}\n")
+    print("\n✅ Resultados guardados en 'hitcost.csv'")
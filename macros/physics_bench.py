@@ -0,0 +1,102 @@
+import os
+import re
+import subprocess
+import sys
+
+# --- Comparación de listas de física: QGSP_BERT_HP vs NeutronHP ---
+# Uso: python3 physics_bench.py [eventos] [ejecutable]
+#
+# Cada lista se corre en modo secuencial sin caché de tablas (arranque en
+# frío) y se mide el tiempo de arranque por fase, la memoria máxima (RSS) y
+# los eventos/s. El espectro transmitido se compara con 15 bandas
+# logarítmicas (1 meV a 10 MeV) contra QGSP_BERT_HP: con la misma física de
+# neutrones las diferencias deben ser sólo estadísticas (χ²/ndf ~ 1).
+# NeutronHP_TS cambia a propósito la región térmica (S(α,β) por debajo de
+# 4 eV), así que sus bandas térmicas pueden diferir.
+
+n_events = int(sys.argv[1]) if len(sys.argv) > 1 else 200000
+exe = sys.argv[2] if len(sys.argv) > 2 else "./Neutron_Thermalization"
+lists = ["QGSP_BERT_HP", "NeutronHP", "NeutronHP_TS"]
+
+edges = " ".join(f"{10 ** (-3 + k * 10 / 14):.4g}" for k in range(15))  # 1 meV ... 10 MeV
+
+macro = f"""\
+/control/verbose 0
+/run/verbose 0
+/run/initialize
+/gun/particle neutron
+/gun/energy 4.2 MeV
+/gun/position 0 0 -2.6 cm
+/gun/direction 0 0 1
+/tally/bands {edges} eV
+/run/beamOn {n_events}
+"""
+with open("physics_bench.mac", "w") as f:
+    f.write(macro)
+
+patterns = {
+    "fisica": re.compile(r"Arranque física:\s+([0-9.eE+-]+)"),
+    "tablas": re.compile(r"Arranque tablas físicas \+ HP:\s+([0-9.eE+-]+)"),
+    "total":  re.compile(r"Arranque total:\s+([0-9.eE+-]+)"),
+    "rate":   re.compile(r"Eventos/s:\s+([0-9.eE+-]+)"),
+}
+
+
+def read_tallies(path):
+    bands = []
+    with open(path) as f:
+        for line in f:
+            if line.startswith(("#", "Banda,")) or not line.strip():
+                continue
+            label, _, _, n, error = line.strip().split(",")[:5]
+            if label != "Detectados":
+                bands.append((label, float(n), float(error)))
+    return bands
+
+
+results = {}
+for name in lists:
+    print(f"🔹 {name}, {n_events} eventos...")
+    log_name = f"physics_{name}.log"
+    with open(log_name, "w") as log:
+        proc = subprocess.Popen([exe, "physics_bench.mac", "-m", "serial", "-p", name,
+                                 "--no-cache", "-o", f"physics_{name}"],
+                                stdout=log, stderr=subprocess.STDOUT)
+        _, status, usage = os.wait4(proc.pid, 0)
+    with open(log_name) as log:
+        out = log.read()
+    values = {key: p.search(out) for key, p in patterns.items()}
+    if status != 0 or not all(values.values()):
+        print(f"⚠️ No se encontraron los tiempos en la salida (ver {log_name}).")
+        continue
+    entry = {key: float(m.group(1)) for key, m in values.items()}
+    entry["rss_mb"] = usage.ru_maxrss / 1024.  # Linux: KiB
+    entry["bands"] = read_tallies(f"physics_{name}_tallies.csv")
+    results[name] = entry
+
+if not results:
+    sys.exit(1)
+
+print("\n Lista           Física (s)   Tablas (s)   Arranque (s)   RSS (MB)   Eventos/s")
+with open("physics_bench.csv", "w") as f:
+    f.write("Lista,Fisica_s,Tablas_s,Arranque_s,RSS_MB,EventosPorSegundo,Chi2,Ndf\n")
+    reference = results.get("QGSP_BERT_HP")
+    for name, r in results.items():
+        print(f" {name:14s} {r['fisica']:11.2f} {r['tablas']:12.2f} {r['total']:14.2f}"
+              f" {r['rss_mb']:10.0f} {r['rate']:11.0f}")
+
+        chi2, ndf, worst = 0., 0, (0., "")
+        if reference and name != "QGSP_BERT_HP":
+            for (label, n, e), (_, n0, e0) in zip(r["bands"], reference["bands"]):
+                if e * e + e0 * e0 == 0.:
+                    continue
+                z = (n - n0) / (e * e + e0 * e0) ** 0.5
+                chi2 += z * z
+                ndf += 1
+                if abs(z) > abs(worst[0]):
+                    worst = (z, label)
+            print(f"   espectro vs QGSP_BERT_HP: χ²/ndf = {chi2:.1f}/{ndf}"
+                  f", peor banda {worst[1]} ({worst[0]:+.1f} σ)")
+        f.write(f"{name},{r['fisica']},{r['tablas']},{r['total']},{r['rss_mb']},{r['rate']},{chi2},{ndf}\n")
+
+print("\n✅ Resultados guardados en 'physics_bench.csv'")
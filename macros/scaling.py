@@ -0,0 +1,65 @@
+import os
+import re
+import subprocess
+import sys
+
+# --- Reporte de escalamiento: eventos/s con 1, 2, 4 ... N hilos ---
+# Uso: python3 scaling.py [max_hilos] [eventos] [modo]
+#   modo: mt (por defecto) o tasking
+
+exe = "./Neutron_Thermalization"
+
+max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else os.cpu_count()
+n_events = int(sys.argv[2]) if len(sys.argv) > 2 else 20000
+mode = sys.argv[3] if len(sys.argv) > 3 else "mt"
+
+macro_content = f"""\
+/control/verbose 0
+/run/verbose 0
+/event/verbose 0
+/tracking/verbose 0
+
+/run/initialize
+
+/gun/particle neutron
+/gun/energy 4.2 MeV
+/gun/position 0 0 -2.6 cm
+/gun/direction 0 0 1
+
+/run/beamOn {n_events}
+"""
+macro_file = "scaling.mac"
+with open(macro_file, "w") as f:
+    f.write(macro_content)
+
+# 1, 2, 4, ... hasta max_threads (incluyendo max_threads)
+thread_counts = []
+n = 1
+while n < max_threads:
+    thread_counts.append(n)
+    n *= 2
+thread_counts.append(max_threads)
+
+rate_re = re.compile(r"Eventos/s:\s+([0-9.eE+-]+)")
+results = []
+
+for nt in thread_counts:
+    print(f"🔹 {nt} hilo(s), {n_events} eventos...")
+    out = subprocess.run([exe, macro_file, "-m", mode, "-t", str(nt)],
+                         capture_output=True, text=True).stdout
+    match = rate_re.search(out)
+    if not match:
+        print("⚠️ No se encontró la tasa de eventos en la salida.")
+        continue
+    results.append((nt, float(match.group(1))))
+
+if results:
+    base = results[0][1]
+    print("\n Hilos   Eventos/s   Aceleración   Eficiencia")
+    with open("scaling.csv", "w") as f:
+        f.write("Hilos,EventosPorSegundo,Aceleracion,Eficiencia\n")
+        for nt, rate in results:
+            speedup = rate / base
+            print(f" {nt:5d} {rate:11.1f} {speedup:12.2f} {speedup / nt:12.2f}")
+            f.write(f"{nt},{rate},{speedup},{speedup / nt}\n")
+    print("\n✅ Resultados guardados en 'scaling.csv'")
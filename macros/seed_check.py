@@ -0,0 +1,103 @@
+import argparse
+import os
+import subprocess
+import sys
+
+import numpy as np
+
+from columnar import load
+
+# --- Regresión de semillas por evento (/seed/perEvent) ---
+# Uso: python3 seed_check.py [macro.mac] [--events N] [--threads 2 4] [--shards 3]
+#
+# Corre el mismo macro en modo secuencial, multihilo con cada número de
+# hilos pedido y repartido en shards (macros/shards.py --per-event-seeds), y
+# compara contra el run secuencial:
+#   - los conteos por banda de <nombre>_tallies.csv, que deben ser iguales;
+#   - cada columna de la ntuple columnar ordenada (el orden de las filas
+#     depende de qué hilo termina primero, los valores no). Si cada
+#     neutrón transmitido es idéntico, los histogramas también lo son.
+# Sale con código 1 si algo difiere: un cambio de paralelismo se valida
+# con un diff y no con una comparación estadística.
+
+parser = argparse.ArgumentParser(description="Runs secuencial, MT y por shards deben coincidir")
+parser.add_argument("macro", nargs="?", default=None)
+parser.add_argument("--events", type=int, default=2000)
+parser.add_argument("--threads", type=int, nargs="*", default=[2, 4])
+parser.add_argument("--shards", type=int, default=3)
+parser.add_argument("--seed", type=int, default=12345)
+parser.add_argument("--exe", default="./Neutron_Thermalization")
+args = parser.parse_args()
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+# Macro base: el del usuario sin beamOn ni semillas, o una fuente simple
+skipped = ("/run/beamOn", "/random/setSeeds", "/output/", "/seed/")
+if args.macro:
+    with open(args.macro) as f:
+        body = [line for line in f.read().splitlines() if not line.strip().startswith(skipped)]
+else:
+    body = ["/control/verbose 0", "/run/verbose 0", "/run/initialize",
+            "/gun/particle neutron", "/gun/energy 4.2 MeV",
+            "/gun/position 0 0 -2.6 cm", "/gun/direction 0 0 1"]
+body += [f"/seed/perEvent true", f"/seed/master {args.seed}",
+         "/output/ntuple true", "/output/format columnar"]
+
+with open("seed_check.mac", "w") as f:
+    f.write("\n".join(body) + "\n")
+with open("seed_check_run.mac", "w") as f:
+    f.write("\n".join(body) + f"\n/run/beamOn {args.events}\n")
+
+
+def run(name, command):
+    print(f"🔹 {name}...")
+    with open(name + ".log", "w") as log:
+        status = subprocess.run(command, stdout=log, stderr=subprocess.STDOUT).returncode
+    if status != 0:
+        print(f"⚠️ {name} terminó con código {status} (ver {name}.log)")
+    return status == 0
+
+
+configs = {"seed_serial": [args.exe, "seed_check_run.mac", "-m", "serial", "-o", "seed_serial"]}
+for t in args.threads:
+    configs[f"seed_mt{t}"] = [args.exe, "seed_check_run.mac", "-m", "mt", "-t", str(t), "-o", f"seed_mt{t}"]
+if args.shards > 1:
+    configs[f"seed_shards{args.shards}"] = [
+        sys.executable, os.path.join(here, "shards.py"), "seed_check.mac", str(args.events),
+        "--shards", str(args.shards), "--jobs", str(args.shards), "--per-event-seeds",
+        "--seed", str(args.seed), "--output", f"seed_shards{args.shards}", "--exe", args.exe]
+
+done = [name for name, command in configs.items() if run(name, command)]
+if "seed_serial" not in done:
+    sys.exit(1)
+
+
+def read_counts(name):
+    counts = {}
+    with open(name + "_tallies.csv") as f:
+        for line in f:
+            if line.startswith(("#", "Banda,")) or not line.strip():
+                continue
+            label, _, _, n = line.strip().split(",")[:4]
+            counts[label] = float(n)
+    return counts
+
+
+reference_counts = read_counts("seed_serial")
+reference_cols = load("seed_serial_cols")
+
+failed = False
+print("\n Configuración        Conteos   Ntuple")
+for name in done[1:]:
+    counts_ok = read_counts(name) == reference_counts
+    cols = load(name + "_cols")
+    # EventID se numera por shard; el resto de las columnas debe coincidir
+    cols_ok = all(np.array_equal(np.sort(reference_cols[c]), np.sort(cols[c]))
+                  for c in reference_cols if c != "EventID")
+    print(f" {name:20s} {'igual' if counts_ok else 'DISTINTO':9s} {'igual' if cols_ok else 'DISTINTA'}")
+    failed |= not (counts_ok and cols_ok)
+
+if failed or len(done) < len(configs):
+    print("\n❌ Los resultados dependen del paralelismo")
+    sys.exit(1)
+print("\n✅ Secuencial, multihilo y shards dan resultados idénticos")
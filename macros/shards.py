@@ -0,0 +1,295 @@
+import argparse
+import glob
+import hashlib
+import json
+import math
+import os
+import queue
+import re
+import shutil
+import struct
+import subprocess
+import threading
+import time
+import zlib
+from concurrent.futures import ThreadPoolExecutor
+
+# --- Un run lógico repartido en varios procesos locales (shards) ---
+# Uso: python3 shards.py macro.mac eventos [--shards S] [--jobs J] [--threads T]
+#                        [--pin none|cores|numa] [--seed N] [--output nombre]
+#                        [--per-event-seeds]
+#
+# El macro se usa sin sus líneas /run/beamOn, /random/setSeeds y
+# /output/fileName: cada shard agrega su semilla, su nombre de salida
+# (<nombre>_shardNNN) y su parte de los eventos. Los shards se corren con
+# una cola de trabajo de J procesos simultáneos, opcionalmente fijados a
+# grupos de núcleos (taskset) o a nodos NUMA (numactl). Al final se unen
+# los conteos por banda, la ntuple columnar, la malla de flujo, la
+# termalización, los píxeles y los planos (flux.combine) y, si está hadd,
+# los ROOT.
+#
+# Con --per-event-seeds los shards usan /seed/perEvent con la semilla base y
+# el desplazamiento de sus eventos: el resultado unido es el mismo que el de
+# un solo proceso, con cualquier número de shards (macros/seed_check.py).
+
+parser = argparse.ArgumentParser(description="Run repartido en procesos locales")
+parser.add_argument("macro")
+parser.add_argument("events", type=int)
+parser.add_argument("--shards", type=int, default=0, help="número de shards (por defecto 4 por proceso simultáneo)")
+parser.add_argument("--jobs", type=int, default=0, help="procesos simultáneos (por defecto núcleos/hilos o nodos NUMA)")
+parser.add_argument("--threads", type=int, default=1, help="hilos por proceso (1: modo secuencial)")
+parser.add_argument("--pin", choices=["none", "cores", "numa"], default="none")
+parser.add_argument("--seed", type=int, default=12345, help="semilla base")
+parser.add_argument("--output", default="NeutronData", help="nombre base de la salida unida")
+parser.add_argument("--per-event-seeds", action="store_true",
+                    help="semillas por evento (/seed/): resultado independiente del número de shards")
+parser.add_argument("--exe", default="./Neutron_Thermalization")
+args = parser.parse_args()
+
+
+# ------------------------------------------------------------
+# Grupos de CPU para fijar los procesos
+# ------------------------------------------------------------
+def parse_cpulist(text):
+    cpus = []
+    for part in text.strip().split(","):
+        if "-" in part:
+            a, b = part.split("-")
+            cpus.extend(range(int(a), int(b) + 1))
+        elif part:
+            cpus.append(int(part))
+    return cpus
+
+
+def numa_nodes():
+    nodes = []
+    for path in sorted(glob.glob("/sys/devices/system/node/node[0-9]*/cpulist")):
+        node = int(re.search(r"node(\d+)", path).group(1))
+        with open(path) as f:
+            nodes.append((node, parse_cpulist(f.read())))
+    return nodes
+
+
+cpus = sorted(os.sched_getaffinity(0)) if hasattr(os, "sched_getaffinity") else list(range(os.cpu_count()))
+nodes = numa_nodes() if args.pin == "numa" else []
+
+jobs = args.jobs
+if jobs <= 0:
+    jobs = len(nodes) if nodes else max(1, len(cpus) // args.threads)
+
+# Un prefijo de comando por lugar de la cola (cada proceso toma un lugar libre)
+slots = []
+for k in range(jobs):
+    if args.pin == "numa" and nodes:
+        node, node_cpus = nodes[k % len(nodes)]
+        if shutil.which("numactl"):
+            slots.append(["numactl", f"--cpunodebind={node}", f"--membind={node}"])
+        else:
+            slots.append(["taskset", "-c", ",".join(map(str, node_cpus))])
+    elif args.pin == "cores":
+        group = cpus[k * args.threads:(k + 1) * args.threads] or cpus[-args.threads:]
+        slots.append(["taskset", "-c", ",".join(map(str, group))])
+    else:
+        slots.append([])
+
+# ------------------------------------------------------------
+# Shards: eventos y semillas
+# ------------------------------------------------------------
+n_shards = args.shards if args.shards > 0 else 4 * jobs
+n_shards = min(n_shards, args.events)
+base, extra = divmod(args.events, n_shards)
+shard_events = [base + (1 if i < extra else 0) for i in range(n_shards)]
+shard_offsets = [sum(shard_events[:i]) for i in range(n_shards)]
+
+
+def shard_seeds(i):
+    """Dos semillas de 31 bits independientes por shard, derivadas de la semilla base."""
+    digest = hashlib.sha256(f"{args.seed}:{i}".encode()).digest()
+    return (int.from_bytes(digest[0:4], "little") & 0x7fffffff,
+            int.from_bytes(digest[4:8], "little") & 0x7fffffff)
+
+
+with open(args.macro) as f:
+    skipped = ("/run/beamOn", "/random/setSeeds", "/output/fileName", "/seed/master", "/seed/eventOffset")
+    body = [line for line in f.read().splitlines() if not line.strip().startswith(skipped)]
+
+
+def shard_name(i):
+    return f"{args.output}_shard{i:03d}"
+
+
+# ------------------------------------------------------------
+# Cola de trabajo
+# ------------------------------------------------------------
+free_slots = queue.Queue()
+for k in range(jobs):
+    free_slots.put(k)
+print_lock = threading.Lock()
+
+
+def run_shard(i):
+    s1, s2 = shard_seeds(i)
+    name = shard_name(i)
+    with open(name + ".mac", "w") as f:
+        f.write("\n".join(body) + "\n")
+        if args.per_event_seeds:
+            f.write(f"/seed/perEvent true\n/seed/master {args.seed}\n/seed/eventOffset {shard_offsets[i]}\n")
+        else:
+            f.write(f"/random/setSeeds {s1} {s2}\n")
+        f.write(f"/output/fileName {name}\n")
+        f.write(f"/run/beamOn {shard_events[i]}\n")
+
+    mode = ["-m", "serial"] if args.threads == 1 else ["-m", "mt", "-t", str(args.threads)]
+    slot = free_slots.get()
+    try:
+        command = slots[slot] + [args.exe, name + ".mac", "-o", name] + mode
+        start = time.time()
+        with open(name + ".log", "w") as log:
+            status = subprocess.run(command, stdout=log, stderr=subprocess.STDOUT).returncode
+        elapsed = time.time() - start
+    finally:
+        free_slots.put(slot)
+
+    with print_lock:
+        state = "✅" if status == 0 else f"⚠️ código {status}"
+        print(f" shard {i:3d}: {shard_events[i]} eventos en {elapsed:.1f} s {state}")
+    return (i, s1, s2, elapsed, status)
+
+
+print(f"🔹 {args.events} eventos en {n_shards} shards, {jobs} procesos simultáneos "
+      f"de {args.threads} hilo(s), fijación: {args.pin}")
+start = time.time()
+with ThreadPoolExecutor(max_workers=jobs) as pool:
+    results = sorted(pool.map(run_shard, range(n_shards)))
+wall = time.time() - start
+
+with open(args.output + "_shards.csv", "w") as f:
+    f.write("Shard,Eventos,Semilla1,Semilla2,Tiempo_s,Codigo\n")
+    for i, s1, s2, elapsed, status in results:
+        f.write(f"{i},{shard_events[i]},{s1},{s2},{elapsed},{status}\n")
+
+done = [shard_name(i) for i, _, _, _, status in results if status == 0]
+if len(done) < n_shards:
+    print(f"⚠️ {n_shards - len(done)} shards fallaron (ver <shard>.log); se unen sólo los terminados.")
+print(f"🔹 Tiempo total: {wall:.1f} s ({args.events / wall:.0f} eventos/s)")
+
+
+# ------------------------------------------------------------
+# Unión de los conteos por banda (<nombre>_tallies.csv)
+# ------------------------------------------------------------
+# Los shards son independientes: conteos y varianzas se suman. La FOM usa
+# la suma de los tiempos de los shards (costo total de CPU).
+def merge_tallies(names, output):
+    events, run_time, rows = 0, 0., {}
+    order = []
+    for name in names:
+        path = name + "_tallies.csv"
+        if not os.path.exists(path):
+            continue
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if line.startswith("# Eventos:"):
+                    events += int(line.split(":")[1])
+                elif line.startswith("# Tiempo_s:"):
+                    run_time += float(line.split(":")[1])
+                elif line and not line.startswith(("#", "Banda,")):
+                    label, emin, emax, n, error = line.split(",")[:5]
+                    if label not in rows:
+                        order.append(label)
+                        rows[label] = [emin, emax, 0., 0.]
+                    rows[label][2] += float(n)
+                    rows[label][3] += float(error) ** 2
+    if not order:
+        return
+    with open(output, "w") as f:
+        f.write(f"# Eventos: {events}\n# Tiempo_s: {run_time}\n")
+        f.write("Banda,Emin_eV,Emax_eV,Conteos,Error,PorEvento,FOM\n")
+        for label in order:
+            emin, emax, n, var = rows[label]
+            fom = n * n / (var * run_time) if n > 0 and var > 0 and run_time > 0 else 0.
+            f.write(f"{label},{emin},{emax},{n},{math.sqrt(var)},{n / events if events else 0.},{fom}\n")
+    print(f"✅ Conteos unidos en '{output}'")
+
+
+# ------------------------------------------------------------
+# Unión de la ntuple columnar (<nombre>_cols/)
+# ------------------------------------------------------------
+# Las columnas numéricas se concatenan; los códigos de las columnas
+# enumeradas se traducen al diccionario unido (cada proceso numera sus
+# etiquetas en el orden en que las vio).
+def column_blocks(path, compressed):
+    """Bloques crudos de un archivo de columna (descomprimidos si hace falta)."""
+    with open(path, "rb") as part:
+        while True:
+            if compressed:
+                header = part.read(8)
+                if len(header) < 8:
+                    return
+                raw, size = struct.unpack("=II", header)
+                yield zlib.decompress(part.read(size))
+                continue
+            block = part.read(1 << 24)
+            if not block:
+                return
+            yield block
+
+
+# La salida unida queda sin comprimir, legible con np.memmap
+def merge_columnar(names, output):
+    dirs = [n + "_cols" for n in names if os.path.exists(os.path.join(n + "_cols", "schema.json"))]
+    if not dirs:
+        return
+    schemas = []
+    for d in dirs:
+        with open(os.path.join(d, "schema.json")) as f:
+            schemas.append(json.load(f))
+
+    os.makedirs(output, exist_ok=True)
+    merged = {"name": schemas[0]["name"], "rows": sum(s["rows"] for s in schemas), "columns": []}
+    for c, column in enumerate(schemas[0]["columns"]):
+        out_column = dict(column)
+        out_column.pop("compression", None)
+        tables = []
+        if "labels" in column:
+            labels = []
+            for s in schemas:
+                table = bytearray(range(256))
+                for code, label in enumerate(s["columns"][c]["labels"]):
+                    if label not in labels and len(labels) < column["other_code"]:
+                        labels.append(label)
+                    table[code] = labels.index(label) if label in labels else column["other_code"]
+                tables.append(bytes(table))
+            out_column["labels"] = labels
+        merged["columns"].append(out_column)
+
+        with open(os.path.join(output, column["file"]), "wb") as out:
+            for k, d in enumerate(dirs):
+                compressed = schemas[k]["columns"][c].get("compression") == "zlib"
+                for block in column_blocks(os.path.join(d, column["file"]), compressed):
+                    out.write(block.translate(tables[k]) if tables else block)
+
+    with open(os.path.join(output, "schema.json"), "w") as f:
+        json.dump(merged, f, indent=2)
+    print(f"✅ Ntuple columnar unida en '{output}/' ({merged['rows']} filas)")
+
+
+merge_tallies(done, args.output + "_tallies.csv")
+merge_columnar(done, args.output + "_cols")
+
+# Malla de flujo, termalización, píxeles y planos (macros/flux.py, numpy)
+try:
+    from flux import combine
+except ImportError:
+    print(f"⚠️ Sin numpy: unir flujo, píxeles y planos con "
+          f"'python3 flux.py --combine {args.output} {args.output}_shard*_flux.json'")
+else:
+    combine(done, args.output)
+
+roots = [n + ".root" for n in done if os.path.exists(n + ".root")]
+if roots:
+    if shutil.which("hadd"):
+        subprocess.run(["hadd", "-f", args.output + ".root"] + roots, stdout=subprocess.DEVNULL)
+        print(f"✅ Histogramas y ntuple ROOT unidos en '{args.output}.root'")
+    else:
+        print(f"⚠️ hadd no está disponible: unir con 'hadd {args.output}.root {args.output}_shard*.root'")
@@ -0,0 +1,45 @@
+import math
+import sys
+
+# --- Espectros de ejemplo para /source/spectrum (formato "E_MeV densidad", lin) ---
+# Uso: python3 spectra.py [cf252|dd] [archivo]
+#
+#   cf252: espectro de Watt de la fisión espontánea del Cf-252
+#          (a = 1.025 MeV, b = 2.926 1/MeV), de 1 keV a 20 MeV
+#   dd:    línea D-D de 2.45 MeV con un ancho gaussiano (FWHM 0.1 MeV)
+#
+# Espectros medidos (AmBe, ISO 8529) se usan directamente con el modo
+# hist: una línea "E_inferior peso_del_grupo" por grupo y un último E
+# superior.
+#
+#   /source/spectrum cf252_watt.dat MeV lin
+
+
+def watt(E, a=1.025, b=2.926):
+    return math.exp(-E / a) * math.sinh(math.sqrt(b * E))
+
+
+def gaussian(E, mean=2.45, fwhm=0.1):
+    sigma = fwhm / 2.3548
+    return math.exp(-0.5 * ((E - mean) / sigma) ** 2)
+
+
+kind = sys.argv[1] if len(sys.argv) > 1 else "cf252"
+if kind == "cf252":
+    # 60 puntos por década entre 1 keV y 20 MeV
+    energies = [10 ** (-3 + k / 60) for k in range(int(60 * math.log10(20e3)) + 1)]
+    values = [watt(E) for E in energies]
+    default = "cf252_watt.dat"
+elif kind == "dd":
+    energies = [2.45 + 0.3 * (k / 200 - 0.5) for k in range(201)]
+    values = [gaussian(E) for E in energies]
+    default = "dd_2.45MeV.dat"
+else:
+    sys.exit(f"Espectro desconocido: {kind} (cf252 o dd)")
+
+out = sys.argv[2] if len(sys.argv) > 2 else default
+with open(out, "w") as f:
+    f.write(f"# {kind}: E (MeV)  densidad (interpolación lineal)\n")
+    for E, v in zip(energies, values):
+        f.write(f"{E:.6g} {v:.6g}\n")
+print(f"✅ Espectro {kind} guardado en '{out}' ({len(energies)} puntos)")
@@ -1,33 +1,160 @@
-#include "G4RunManager.hh"
+#include "G4RunManagerFactory.hh"
 #include "G4UImanager.hh"
 #include "QGSP_BERT_HP.hh"
+#include "G4StepLimiterPhysics.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
 #include "G4Timer.hh"
 
 #include "ActionInitialization.hh"
 #include "DetectorConstruction.hh"
+#include "GeometrySweep.hh"
+#include "NeutronPhysicsList.hh"
+#include "ImportanceWorld.hh"
+#include "PhysicsTableCache.hh"
+#include "RunDriver.hh"
+#include "Convergence.hh"
+#include "StartupProfiler.hh"
+
+#include <cstdlib>
+
+namespace {
+
+void PrintUsage()
+{
+    G4cerr << " Uso: Neutron_Thermalization [macro] [-t hilos] [-m serial|mt|tasking]" << G4endl;
+    G4cerr << "                                 [-c directorio | --no-cache] [-b] [--profile]" << G4endl;
+    G4cerr << "                                 [-o nombre] [-p física]" << G4endl;
+    G4cerr << "   -t, --threads  Número de hilos de trabajo (0 = valor por defecto de Geant4)" << G4endl;
+    G4cerr << "   -m, --mode     Tipo de Run Manager: serial, mt o tasking" << G4endl;
+    G4cerr << "   -c, --cache    Directorio de la caché de tablas físicas (physics_cache)" << G4endl;
+    G4cerr << "   --no-cache     No guardar ni recuperar tablas físicas" << G4endl;
+    G4cerr << "   -o, --output   Nombre base de la salida (igual que /output/fileName)" << G4endl;
+    G4cerr << "   -p, --physics  Lista de física: QGSP_BERT_HP (por defecto), NeutronHP o NeutronHP_TS" << G4endl;
+    G4cerr << "                  (NeutronHP: sólo neutrones HP y EM estándar; _TS: con S(α,β) en la parafina)" << G4endl;
+    G4cerr << "   -b, --biasing  Muestreo por importancia en la parafina (comandos /biasing/)" << G4endl;
+    G4cerr << "   --profile      Perfil de pasos y tiempo por volumen, partícula y proceso" << G4endl;
+    G4cerr << " El número de hilos también puede fijarse en el macro con /run/numberOfThreads." << G4endl;
+}
+
+}
 
 int main(int argc, char** argv) {
+    // --- Argumentos de línea de comandos ---
+    G4String macro;
+    G4String mode = "default";
+    G4int nThreads = 0;
+    G4String cacheDir = "physics_cache";
+    G4String output;
+    G4String physicsName = "QGSP_BERT_HP";
+    G4bool biasing = false;
+    G4bool profile = false;
+
+    for (G4int i = 1; i < argc; ++i) {
+        G4String arg = argv[i];
+        if ((arg == "-t" || arg == "--threads") && i + 1 < argc) {
+            nThreads = std::atoi(argv[++i]);
+        } else if ((arg == "-m" || arg == "--mode") && i + 1 < argc) {
+            mode = argv[++i];
+        } else if ((arg == "-c" || arg == "--cache") && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+        } else if ((arg == "-p" || arg == "--physics") && i + 1 < argc) {
+            physicsName = argv[++i];
+        } else if (arg == "--no-cache") {
+            cacheDir = "";
+        } else if (arg == "-b" || arg == "--biasing") {
+            biasing = true;
+        } else if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else if (arg[0] == '-') {
+            PrintUsage();
+            return 1;
+        } else {
+            macro = arg;
+        }
+    }
+
+    if (physicsName != "QGSP_BERT_HP" && physicsName != "NeutronHP" && physicsName != "NeutronHP_TS") {
+        PrintUsage();
+        return 1;
+    }
+
+    // Tiempos de arranque por fase (se reportan al terminar el primer run)
+    StartupProfiler* profiler = nullptr;
+
     // Interfaz de usuario (modo interactivo si no hay macro)
     G4UIExecutive* ui = nullptr;
-    if (argc == 1) ui = new G4UIExecutive(argc, argv);
+    if (macro.empty()) ui = new G4UIExecutive(argc, argv);
+
+    // Crear el Run Manager (secuencial, MT o tasking)
+    G4RunManagerType type = G4RunManagerType::Default;
+    if (mode == "serial")       type = G4RunManagerType::SerialOnly;
+    else if (mode == "mt")      type = G4RunManagerType::MTOnly;
+    else if (mode == "tasking") type = G4RunManagerType::TaskingOnly;
+    else if (mode != "default") {
+        PrintUsage();
+        return 1;
+    }
 
-    // Crear el Run Manager
-    auto* runManager = new G4RunManager();
+    auto* runManager = G4RunManagerFactory::CreateRunManager(type);
+    if (nThreads > 0) runManager->SetNumberOfThreads(nThreads);
 
     // Construcción del detector
-    runManager->SetUserInitialization(new DetectorConstruction());
+    auto* detector = new DetectorConstruction();
+    runManager->SetUserInitialization(detector);
+    profiler = new StartupProfiler(detector);
+
+    // Mundo paralelo de celdas de importancia (sólo con -b)
+    ImportanceWorld* importanceWorld = nullptr;
+    if (biasing) {
+        importanceWorld = new ImportanceWorld(detector);
+        detector->SetImportanceWorld(importanceWorld);
+    }
 
-    // Lista de física
-    runManager->SetUserInitialization(new QGSP_BERT_HP);
+    // Largo de run adaptativo (/convergence/), usado por el barrido y el driver
+    auto* convergence = new Convergence();
 
-    // Inicialización de acciones (PrimaryGenerator, RunAction, EventAction, etc.)
-    runManager->SetUserInitialization(new ActionInitialization());
+    // Barrido de geometrías en el mismo proceso (/detector/sweep/)
+    auto* sweep = new GeometrySweep(detector, convergence);
+
+    // Runs largos en tramos con puntos de control (/driver/)
+    auto* driver = new RunDriver(convergence);
+
+    // Lista de física: completa o reducida a neutrones HP
+    G4VModularPhysicsList* physicsList = nullptr;
+    if (physicsName == "QGSP_BERT_HP") {
+        physicsList = new QGSP_BERT_HP;
+    } else {
+        G4bool thermal = (physicsName == "NeutronHP_TS");
+        // S(α,β) del hidrógeno ligado: la parafina usa el elemento TS_H_of_Polyethylene
+        detector->SetThermalScattering(thermal);
+        physicsList = new NeutronPhysicsList(thermal);
+    }
+    // Proceso G4StepLimiter: aplica los G4UserLimits de /detector/stepLimit/
+    physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+    // Splitting y ruleta rusa en las celdas del mundo paralelo
+    if (importanceWorld) importanceWorld->RegisterPhysics(physicsList);
+    runManager->SetUserInitialization(physicsList);
 
-    // Inicializar el sistema de visualización
-    auto* visManager = new G4VisExecutive();
-    visManager->Initialize();
+    // Caché de tablas físicas en disco (clave: física, materiales y cortes)
+    PhysicsTableCache* cache = nullptr;
+    if (!cacheDir.empty()) cache = new PhysicsTableCache(physicsList, physicsName, cacheDir);
+
+    // Inicialización de acciones (PrimaryGenerator, RunAction, EventAction, etc.)
+    runManager->SetUserInitialization(new ActionInitialization(profile));
+
+    // Inicializar el sistema de visualización (sólo en modo interactivo:
+    // en modo batch nunca se construye)
+    G4VisManager* visManager = nullptr;
+    if (ui) {
+        visManager = new G4VisExecutive();
+        visManager->Initialize();
+    }
 
     // Obtener el gestor de comandos
     G4UImanager* UImanager = G4UImanager::GetUIpointer();
@@ -37,11 +164,14 @@ int main(int argc, char** argv) {
     timer->Start();
 
 
+    // Nombre de la salida de este proceso (procesos concurrentes en el mismo
+    // directorio, ver macros/shards.py); el macro todavía puede cambiarlo
+    if (!output.empty()) UImanager->ApplyCommand("/output/fileName " + output);
+
     if (!ui) {
         // Modo batch (ejecutar macro desde línea de comandos)
         G4String command = "/control/execute ";
-        G4String fileName = argv[1];
-        UImanager->ApplyCommand(command + fileName);
+        UImanager->ApplyCommand(command + macro);
     } else {
         // Modo interactivo (interfaz gráfica)
         UImanager->ApplyCommand("/control/execute ../macros/vis2.mac");
@@ -54,6 +184,7 @@ int main(int argc, char** argv) {
 
        G4cout << "\n" << "************************************************************" << G4endl;
     G4cout << "  Simulación completada." << G4endl;
+    G4cout << "  Hilos de trabajo:         " << runManager->GetNumberOfThreads() << G4endl;
     G4cout << "  Tiempo Real (Wall Clock): " << timer->GetRealElapsed()  << " segundos." << G4endl;
     G4cout << "  Tiempo de CPU (User):     " << timer->GetUserElapsed()  << " segundos." << G4endl;
     G4cout << "************************************************************" << G4endl;
@@ -63,6 +194,11 @@ int main(int argc, char** argv) {
 
 
     // Limpieza
+    delete driver;
+    delete sweep;
+    delete convergence;
+    delete cache;
+    delete profiler;
     delete visManager;
     delete runManager;
     return 0;
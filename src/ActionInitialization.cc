@@ -2,10 +2,24 @@
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 #include "EventAction.hh"
+#include "StackingAction.hh"
+#include "StackingRules.hh"
+#include "StepProfiler.hh"
+#include "TerminationAction.hh"
+#include "TerminationCuts.hh"
 
 
-ActionInitialization::ActionInitialization() {}
-ActionInitialization::~ActionInitialization() {}
+ActionInitialization::ActionInitialization(G4bool profile)
+ : fStackingRules(new StackingRules()),
+   fTerminationCuts(new TerminationCuts()),
+   fProfile(profile)
+{}
+
+ActionInitialization::~ActionInitialization()
+{
+    delete fStackingRules;
+    delete fTerminationCuts;
+}
 
 void ActionInitialization::BuildForMaster() const
 {
@@ -23,5 +37,16 @@ void ActionInitialization::Build() const
     auto eventAction = new EventAction(runAction);
     SetUserAction(eventAction);
 
+    SetUserAction(new StackingAction(fStackingRules, runAction));
+
+    // Perfil de pasos: tiempo por volumen, partícula y proceso
+    StepProfiler* profiler = nullptr;
+    if (fProfile) {
+        profiler = new StepProfiler();
+        SetUserAction(new ProfileTrackingAction(profiler));
+    }
 
+    // Cortes de terminación de neutrones (/cuts/); la única acción de paso,
+    // dueña del perfilador si lo hay
+    SetUserAction(new TerminationAction(fTerminationCuts, runAction, profiler));
 }
@@ -0,0 +1,42 @@
+#include "AliasTable.hh"
+
+#include <numeric>
+
+// ------------------------------------------------------------
+// Construcción (algoritmo de Vose)
+// ------------------------------------------------------------
+void AliasTable::Build(const std::vector<G4double>& weights)
+{
+    std::size_t n = weights.size();
+    fProbability.assign(n, 1.);
+    fAlias.resize(n);
+    for (std::size_t i = 0; i < n; ++i) fAlias[i] = i;
+
+    G4double total = std::accumulate(weights.begin(), weights.end(), 0.);
+    if (n == 0 || total <= 0.) return;
+
+    // Probabilidades escaladas a media 1: "chicas" (< 1) y "grandes" (>= 1)
+    std::vector<G4double> scaled(n);
+    std::vector<std::size_t> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1. ? small : large).push_back(i);
+    }
+
+    // Cada columna chica se completa con masa de una grande
+    while (!small.empty() && !large.empty()) {
+        std::size_t s = small.back();
+        small.pop_back();
+        std::size_t l = large.back();
+        fProbability[s] = scaled[s];
+        fAlias[s] = l;
+        scaled[l] -= 1. - scaled[s];
+        if (scaled[l] < 1.) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Lo que queda tiene probabilidad 1 (salvo redondeo)
+    for (std::size_t i : large) fProbability[i] = 1.;
+    for (std::size_t i : small) fProbability[i] = 1.;
+}
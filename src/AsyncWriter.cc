@@ -0,0 +1,128 @@
+#include "AsyncWriter.hh"
+
+#include <cstdint>
+#include <fstream>
+
+#ifdef NT_USE_ZLIB
+#include <zlib.h>
+#endif
+
+// ------------------------------------------------------------
+// Instancia del proceso
+// ------------------------------------------------------------
+// El hilo arranca con el primer uso y se detiene al salir del programa,
+// después de escribir lo que quede en la cola.
+AsyncWriter& AsyncWriter::Instance()
+{
+    static AsyncWriter instance;
+    return instance;
+}
+
+AsyncWriter::AsyncWriter()
+{
+    fThread = std::thread(&AsyncWriter::Loop, this);
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fNotEmpty.notify_one();
+    fThread.join();
+}
+
+G4bool AsyncWriter::HasCompression()
+{
+#ifdef NT_USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ------------------------------------------------------------
+// Lado de los hilos de tracking
+// ------------------------------------------------------------
+void AsyncWriter::Push(std::vector<Block>&& batch)
+{
+    std::unique_lock<std::mutex> lock(fMutex);
+    fNotFull.wait(lock, [this] { return fQueue.size() < kMaxBatches; });
+    fQueue.push_back(std::move(batch));
+    lock.unlock();
+    fNotEmpty.notify_one();
+}
+
+void AsyncWriter::Drain()
+{
+    std::unique_lock<std::mutex> lock(fMutex);
+    fIdle.wait(lock, [this] { return fQueue.empty() && !fBusy; });
+}
+
+G4bool AsyncWriter::HasFailed(const G4String& file)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    return fFailed.count(file) > 0;
+}
+
+void AsyncWriter::ClearFailure(const G4String& file)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fFailed.erase(file);
+}
+
+// ------------------------------------------------------------
+// Hilo de escritura
+// ------------------------------------------------------------
+void AsyncWriter::Loop()
+{
+    std::unique_lock<std::mutex> lock(fMutex);
+    while (true) {
+        fNotEmpty.wait(lock, [this] { return fStop || !fQueue.empty(); });
+        if (fQueue.empty()) break;   // fStop y nada pendiente
+
+        std::vector<Block> batch = std::move(fQueue.front());
+        fQueue.pop_front();
+        fBusy = true;
+        lock.unlock();
+        fNotFull.notify_one();
+
+        // Compresión y escritura fuera del candado
+        std::vector<G4String> failed;
+        for (const auto& block : batch) {
+            if (!Write(block)) failed.push_back(block.file);
+        }
+        batch.clear();
+
+        lock.lock();
+        fBusy = false;
+        fFailed.insert(failed.begin(), failed.end());
+        if (fQueue.empty()) fIdle.notify_all();
+    }
+}
+
+G4bool AsyncWriter::Write(const Block& block)
+{
+    if (block.data.empty()) return true;
+    std::ofstream out(block.file, std::ios::binary | std::ios::app);
+
+#ifdef NT_USE_ZLIB
+    if (block.compress) {
+        uLongf size = compressBound(block.data.size());
+        std::vector<Bytef> compressed(size);
+        // Nivel 1: la mayor parte de la ganancia a una fracción del costo
+        if (compress2(compressed.data(), &size, reinterpret_cast<const Bytef*>(block.data.data()),
+                      block.data.size(), 1) != Z_OK) {
+            return false;
+        }
+        std::uint32_t header[2] = {std::uint32_t(block.data.size()), std::uint32_t(size)};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(compressed.data()), size);
+        return bool(out);
+    }
+#endif
+
+    out.write(block.data.data(), block.data.size());
+    return bool(out);
+}
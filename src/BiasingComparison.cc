@@ -0,0 +1,44 @@
+#include "BiasingComparison.hh"
+#include "ImportanceWorld.hh"
+#include "ModeComparison.hh"
+#include "RunAction.hh"
+
+namespace {
+
+enum { kFractionCol, kErrorCol, kFomCol };
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+BiasingComparison::BiasingComparison(ImportanceWorld* world)
+ : fWorld(world)
+{}
+
+// ------------------------------------------------------------
+// Ejecución: análogo y con muestreo
+// ------------------------------------------------------------
+void BiasingComparison::Run(G4int nEvents, const G4String& outputFile)
+{
+    G4bool saved = fWorld->IsEnabled();
+
+    // Fracción transmitida en la banda 0 (térmicos), su error relativo y la FOM
+    ModeComparison comparison("analogo", "análogo", "muestreo", "con muestreo por importancia",
+                              [this](G4bool on) { fWorld->SetEnabled(on); });
+    comparison.AddColumn("Fraccion", "Fracción",
+                         [nEvents](const RunAction& run) { return run.GetBandCount(0) / nEvents; });
+    comparison.AddColumn("ErrorRelativo", "Error rel.", [](const RunAction& run) {
+        G4double count = run.GetBandCount(0);
+        return (count > 0.) ? run.GetBandError(0) / count : 0.;
+    });
+    comparison.AddColumn("FOM", "FOM",
+                         [](const RunAction& run) { return run.GetFigureOfMerit(0); });
+    comparison.Run(nEvents, outputFile);
+
+    fWorld->SetEnabled(saved);
+
+    G4double analog = comparison.GetValue(0, kFomCol);
+    G4cout << " Ganancia en FOM (muestreo/análogo): "
+           << (analog > 0. ? comparison.GetValue(1, kFomCol) / analog : 0.) << G4endl;
+}
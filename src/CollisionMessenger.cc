@@ -0,0 +1,66 @@
+#include "CollisionMessenger.hh"
+#include "CollisionRecorder.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAnInteger.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /collisions/
+// ------------------------------------------------------------
+CollisionMessenger::CollisionMessenger(CollisionRecorder* recorder)
+ : fRecorder(recorder)
+{
+    fCollisionsDir = new G4UIdirectory("/collisions/");
+    fCollisionsDir->SetGuidance("Historias de colisiones de los neutrones en el bloque.");
+
+    fEnableCmd = new G4UIcmdWithABool("/collisions/enable", this);
+    fEnableCmd->SetGuidance("Registra cada colisión hadrónica de los neutrones en el bloque");
+    fEnableCmd->SetGuidance("(desactivado por defecto). Salida: <nombre>_collisions/, una fila por");
+    fEnableCmd->SetGuidance("colisión de las historias que llegan al detector o muestreadas.");
+    fEnableCmd->SetParameterName("enable", true);
+    fEnableCmd->SetDefaultValue(true);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fSampleCmd = new G4UIcmdWithADouble("/collisions/sample", this);
+    fSampleCmd->SetGuidance("Fracción de las historias que NO llegan al detector que también se");
+    fSampleCmd->SetGuidance("escriben (0 por defecto: sólo las detectadas; 1: todas).");
+    fSampleCmd->SetParameterName("fraction", false);
+    fSampleCmd->SetRange("fraction >= 0 && fraction <= 1");
+    fSampleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fArenaCmd = new G4UIcmdWithAnInteger("/collisions/arenaSize", this);
+    fArenaCmd->SetGuidance("Colisiones que caben en la arena de cada hilo por evento (32 bytes");
+    fArenaCmd->SetGuidance("cada una; por defecto 65536). Las que no entran se pierden y se avisa.");
+    fArenaCmd->SetParameterName("records", false);
+    fArenaCmd->SetRange("records > 0");
+    fArenaCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+CollisionMessenger::~CollisionMessenger()
+{
+    delete fEnableCmd;
+    delete fSampleCmd;
+    delete fArenaCmd;
+    delete fCollisionsDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con CollisionRecorder
+// ------------------------------------------------------------
+void CollisionMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fEnableCmd) {
+        fRecorder->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fSampleCmd) {
+        fRecorder->SetSampleFraction(fSampleCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fArenaCmd) {
+        fRecorder->SetArenaSize(fArenaCmd->GetNewIntValue(newValue));
+    }
+}
@@ -0,0 +1,223 @@
+#include "CollisionRecorder.hh"
+#include "CollisionMessenger.hh"
+#include "ColumnarWriter.hh"
+#include "AsyncWriter.hh"
+
+#include "G4HadronicProcessType.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+namespace {
+
+// Columnas de <nombre>_collisions/ (orden de creación)
+enum {
+    kEventCol, kTrackCol, kParentCol, kCollisionCol, kEnergyInCol, kEnergyCol, kTimeCol,
+    kPosXCol, kPosYCol, kPosZCol, kWeightCol, kTargetCol, kProcessCol, kDetectedCol
+};
+
+G4String ProcessLabel(G4int subType)
+{
+    switch (subType) {
+        case fHadronElastic:   return "elastico";
+        case fHadronInelastic: return "inelastico";
+        case fCapture:         return "captura";
+        case fFission:         return "fision";
+        default:               return "otro";
+    }
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+CollisionRecorder::CollisionRecorder()
+{
+    fWriter = new ColumnarWriter("Collisions");
+    fWriter->CreateColumn("EventID", ColumnarWriter::kInt32);
+    fWriter->CreateColumn("TrackID", ColumnarWriter::kInt32);
+    fWriter->CreateColumn("ParentID", ColumnarWriter::kInt32);
+    fWriter->CreateColumn("Collision", ColumnarWriter::kInt32);
+    fWriter->CreateColumn("EnergyIn_eV", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("Energy_eV", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("Time_ns", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("PosX_mm", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("PosY_mm", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("PosZ_mm", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("Weight", ColumnarWriter::kFloat32);
+    fWriter->CreateColumn("TargetZA", ColumnarWriter::kInt32);
+    fWriter->CreateColumn("Process", ColumnarWriter::kEnum8);
+    fWriter->CreateColumn("Detected", ColumnarWriter::kInt32);
+
+    fMessenger = new CollisionMessenger(this);
+}
+
+CollisionRecorder::~CollisionRecorder()
+{
+    delete fMessenger;
+    delete fWriter;
+}
+
+void CollisionRecorder::SetCompression(G4bool value)
+{
+    // Sin zlib ya avisa la ntuple columnar (mismo comando /output/compress)
+    fWriter->SetCompression(value && AsyncWriter::HasCompression());
+}
+
+// ------------------------------------------------------------
+// Run
+// ------------------------------------------------------------
+void CollisionRecorder::Open(const G4String& directory)
+{
+    // La arena se reserva una vez por run; si el tamaño no cambió, la
+    // memoria del run anterior se reutiliza
+    fArena.clear();
+    fArena.reserve(fArenaSize);
+    fHistories.clear();
+    fHistories.reserve(1024);
+    fTrackID = -1;
+    fDropped = 0;
+
+    fWriter->Open(directory);
+    fRecording = true;
+}
+
+void CollisionRecorder::Close()
+{
+    if (!fRecording) return;
+    fWriter->Close();
+    fRecording = false;
+
+    if (fDropped > 0) {
+        G4ExceptionDescription ed;
+        ed << fDropped << " colisiones no entraron en la arena del hilo (" << fArenaSize
+           << " registros por evento); usar /collisions/arenaSize para agrandarla.";
+        G4Exception("CollisionRecorder::Close", "Collisions001", JustWarning, ed);
+    }
+}
+
+std::size_t CollisionRecorder::Merge(G4int nThreads)
+{
+    return fWriter->Merge(nThreads);
+}
+
+// ------------------------------------------------------------
+// Llenado
+// ------------------------------------------------------------
+void CollisionRecorder::SetTrack(G4int trackID, G4int parentID)
+{
+    // Las trazas se siguen una a la vez: un ID nuevo abre una historia
+    // (vacía si la traza no choca en el bloque)
+    if (trackID != fTrackID) {
+        fTrackID = trackID;
+        fHistories.push_back({trackID, parentID, fArena.size()});
+    }
+}
+
+void CollisionRecorder::AddCollision(G4double energyIn, G4double energy, G4double time,
+                                     const G4ThreeVector& position, G4double weight,
+                                     G4int targetZA, G4int processSubType)
+{
+    // Sin lugar en la arena se pierde el registro: nunca se pide memoria
+    // durante el tracking
+    if (G4int(fArena.size()) >= fArenaSize) {
+        ++fDropped;
+        return;
+    }
+
+    Record record;
+    record.energyIn = float(energyIn/eV);
+    record.energy = float(energy/eV);
+    record.time = float(time/ns);
+    record.x = float(position.x()/mm);
+    record.y = float(position.y()/mm);
+    record.z = float(position.z()/mm);
+    record.weight = float(weight);
+    record.targetZA = (targetZA > 0 && targetZA <= 0xFFFF) ? std::uint16_t(targetZA) : 0;
+    record.process = std::uint8_t(std::clamp(processSubType, 0, 255));
+    record.pad = 0;
+    fArena.push_back(record);
+}
+
+// ------------------------------------------------------------
+// Fin de evento
+// ------------------------------------------------------------
+void CollisionRecorder::EndOfEvent(G4int eventID,
+                                   const std::vector<std::pair<G4int, G4int>>& detected)
+{
+    // Madre de cada traza vista en el bloque y de cada traza detectada (un
+    // clon nacido en la salida llega al detector sin pasar por el bloque)
+    fParents.clear();
+    for (const History& history : fHistories) fParents.emplace(history.trackID, history.parentID);
+    for (const auto& track : detected) fParents.emplace(track.first, track.second);
+
+    // Trazas detectadas y toda su ascendencia: con -b las colisiones previas
+    // a cada división quedan en las historias de los antecesores
+    fSelected.clear();
+    for (const auto& track : detected) {
+        fSelected[track.first] = 1;
+        for (G4int id = track.second; id > 0 && fSelected.emplace(id, 2).second;) {
+            auto parent = fParents.find(id);
+            if (parent == fParents.end()) break;
+            id = parent->second;
+        }
+    }
+
+    for (std::size_t h = 0; h < fHistories.size(); ++h) {
+        const History& history = fHistories[h];
+        std::size_t end = (h + 1 < fHistories.size()) ? fHistories[h + 1].first : fArena.size();
+        if (end == history.first) continue;
+        auto selected = fSelected.find(history.trackID);
+        if (selected != fSelected.end()) {
+            WriteHistory(eventID, history, end, selected->second);
+        }
+        else if (IsSampled(eventID, history.trackID)) {
+            WriteHistory(eventID, history, end, 0);
+        }
+    }
+
+    // Las historias no seleccionadas se liberan con la arena
+    fArena.clear();
+    fHistories.clear();
+    fTrackID = -1;
+}
+
+// Muestreo determinista por (evento, traza): no consume números del
+// generador, así que activar el registro no cambia la simulación
+G4bool CollisionRecorder::IsSampled(G4int eventID, G4int trackID) const
+{
+    if (fSample <= 0.) return false;
+    if (fSample >= 1.) return true;
+
+    // splitmix64
+    std::uint64_t x = (std::uint64_t(std::uint32_t(eventID)) << 32) | std::uint32_t(trackID);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return G4double(x >> 11) * (1./9007199254740992.) < fSample;   // [0, 1) con 53 bits
+}
+
+void CollisionRecorder::WriteHistory(G4int eventID, const History& history, std::size_t end,
+                                     G4int detected)
+{
+    for (std::size_t i = history.first; i < end; ++i) {
+        const Record& record = fArena[i];
+        fWriter->FillI(kEventCol, eventID);
+        fWriter->FillI(kTrackCol, history.trackID);
+        fWriter->FillI(kParentCol, history.parentID);
+        fWriter->FillI(kCollisionCol, G4int(i - history.first) + 1);
+        fWriter->FillF(kEnergyInCol, record.energyIn);
+        fWriter->FillF(kEnergyCol, record.energy);
+        fWriter->FillF(kTimeCol, record.time);
+        fWriter->FillF(kPosXCol, record.x);
+        fWriter->FillF(kPosYCol, record.y);
+        fWriter->FillF(kPosZCol, record.z);
+        fWriter->FillF(kWeightCol, record.weight);
+        fWriter->FillI(kTargetCol, record.targetZA);
+        fWriter->FillEnum(kProcessCol, ProcessLabel(record.process));
+        fWriter->FillI(kDetectedCol, detected);
+        fWriter->AddRow();
+    }
+}
@@ -0,0 +1,257 @@
+#include "ColumnarWriter.hh"
+#include "AsyncWriter.hh"
+
+#include "G4Threading.hh"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+std::mutex ColumnarWriter::fgEnumMutex;
+std::map<G4String, std::vector<G4String>> ColumnarWriter::fgEnumLabels;
+
+namespace {
+
+// Texto JSON con comillas y barras escapadas
+G4String JsonString(const G4String& text)
+{
+    G4String quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+// Prefijo de orden de bytes de numpy para la máquina actual
+char ByteOrder()
+{
+    const std::uint16_t one = 1;
+    return (*reinterpret_cast<const char*>(&one) == 1) ? '<' : '>';
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+ColumnarWriter::ColumnarWriter(const G4String& name)
+ : fName(name)
+{}
+
+G4int ColumnarWriter::CreateColumn(const G4String& name, ColumnType type)
+{
+    fColumns.push_back({name, type, {}});
+    fEnumCache.emplace_back();
+    return G4int(fColumns.size()) - 1;
+}
+
+// ------------------------------------------------------------
+// Apertura y cierre (por hilo)
+// ------------------------------------------------------------
+void ColumnarWriter::Open(const G4String& directory)
+{
+    fDirectory = directory;
+    fThreadID = G4Threading::G4GetThreadId();
+
+    // Varios hilos pueden crear el directorio a la vez: se ignora el error
+    std::error_code ec;
+    std::filesystem::create_directories(std::string(fDirectory), ec);
+
+    // Partes de un run anterior de este mismo hilo (y sus errores)
+    for (std::size_t i = 0; i < fColumns.size(); ++i) {
+        std::remove(PartFile(i, fThreadID).c_str());
+        AsyncWriter::Instance().ClearFailure(PartFile(i, fThreadID));
+        fColumns[i].buffer.clear();
+        fColumns[i].buffer.reserve(kChunkRows * TypeSize(fColumns[i].type));
+    }
+    fRowsInChunk = 0;
+    fOpen = true;
+}
+
+void ColumnarWriter::Close()
+{
+    if (!fOpen) return;
+    FlushChunk();
+    fOpen = false;
+
+    // Las partes deben estar completas antes de que el master las una
+    auto& writer = AsyncWriter::Instance();
+    writer.Drain();
+    for (std::size_t i = 0; i < fColumns.size(); ++i) {
+        if (!writer.HasFailed(PartFile(i, fThreadID))) continue;
+        G4ExceptionDescription ed;
+        ed << "Falló la escritura de partes en " << fDirectory;
+        G4Exception("ColumnarWriter::Close", "Columnar002", JustWarning, ed);
+        break;
+    }
+}
+
+void ColumnarWriter::SetCompression(G4bool value)
+{
+    fCompress = value && AsyncWriter::HasCompression();
+    if (value && !fCompress) {
+        G4Exception("ColumnarWriter::SetCompression", "Columnar003", JustWarning,
+                    "Compilado sin zlib: la ntuple columnar se escribe sin comprimir.");
+    }
+}
+
+void ColumnarWriter::AddRow()
+{
+    if (++fRowsInChunk == kChunkRows) FlushChunk();
+}
+
+// Entrega el bloque actual de cada columna al hilo de escritura: los
+// buffers se mueven a la cola y se reservan unos nuevos, así que el hilo
+// de tracking no toca el disco (salvo que espere por la cola llena)
+void ColumnarWriter::FlushChunk()
+{
+    if (fRowsInChunk == 0) return;
+    std::vector<AsyncWriter::Block> batch(fColumns.size());
+    for (std::size_t i = 0; i < fColumns.size(); ++i) {
+        auto& buffer = fColumns[i].buffer;
+        batch[i].file = PartFile(i, fThreadID);
+        batch[i].data = std::move(buffer);
+        batch[i].compress = fCompress;
+        buffer = std::vector<char>();
+        buffer.reserve(kChunkRows * TypeSize(fColumns[i].type));
+    }
+    AsyncWriter::Instance().Push(std::move(batch));
+    fRowsInChunk = 0;
+}
+
+G4String ColumnarWriter::PartFile(G4int column, G4int threadID) const
+{
+    G4String suffix = (threadID < 0) ? "master" : "t" + std::to_string(threadID);
+    return fDirectory + "/" + fColumns[column].name + "." + suffix + ".part";
+}
+
+// ------------------------------------------------------------
+// Columnas enumeradas
+// ------------------------------------------------------------
+std::uint8_t ColumnarWriter::EnumCode(G4int column, const G4String& label)
+{
+    auto& cache = fEnumCache[column];
+    auto it = cache.find(label);
+    if (it != cache.end()) return it->second;
+
+    // Primera vez que este hilo ve la etiqueta: se busca (o se agrega) en
+    // el diccionario compartido
+    std::lock_guard<std::mutex> lock(fgEnumMutex);
+    auto& labels = fgEnumLabels[fName + "/" + fColumns[column].name];
+    std::uint8_t code = kOtherCode;
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] == label) code = std::uint8_t(i);
+    }
+    if (code == kOtherCode && labels.size() < kOtherCode) {
+        code = std::uint8_t(labels.size());
+        labels.push_back(label);
+    }
+    cache[label] = code;
+    return code;
+}
+
+// ------------------------------------------------------------
+// Fusión en el master
+// ------------------------------------------------------------
+std::size_t ColumnarWriter::Merge(G4int nThreads)
+{
+    std::size_t rows = 0;
+
+    for (std::size_t i = 0; i < fColumns.size(); ++i) {
+        G4String fileName = fDirectory + "/" + fColumns[i].name + ".bin";
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+
+        // El master (-1) sólo tiene partes en modo secuencial
+        for (G4int thread = -1; thread < nThreads; ++thread) {
+            G4String partName = PartFile(i, thread);
+            std::ifstream part(partName, std::ios::binary);
+            if (!part) continue;
+            if (part.peek() != std::ifstream::traits_type::eof()) out << part.rdbuf();
+            part.close();
+            std::remove(partName.c_str());
+        }
+
+        std::size_t fileSize = std::size_t(out.tellp());
+        out.close();
+        std::size_t columnRows = RawSize(fileName, fileSize) / TypeSize(fColumns[i].type);
+        if (i == 0) rows = columnRows;
+        else if (columnRows != rows) {
+            G4ExceptionDescription ed;
+            ed << "La columna " << fColumns[i].name << " tiene " << columnRows
+               << " filas (se esperaban " << rows << ")";
+            G4Exception("ColumnarWriter::Merge", "Columnar001", JustWarning, ed);
+        }
+    }
+
+    WriteSchema(rows);
+    return rows;
+}
+
+// Bytes sin comprimir de un archivo de columna: con compresión se suman
+// los tamaños crudos de las cabeceras de los bloques
+std::size_t ColumnarWriter::RawSize(const G4String& fileName, std::size_t fileSize) const
+{
+    if (!fCompress) return fileSize;
+
+    std::ifstream in(fileName, std::ios::binary);
+    std::size_t raw = 0;
+    std::uint32_t header[2];
+    while (in.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        raw += header[0];
+        in.seekg(header[1], std::ios::cur);
+    }
+    return raw;
+}
+
+void ColumnarWriter::WriteSchema(std::size_t rows) const
+{
+    std::ofstream schema(fDirectory + "/schema.json");
+    schema << "{\n  \"name\": " << JsonString(fName) << ",\n"
+           << "  \"rows\": " << rows << ",\n"
+           << "  \"columns\": [\n";
+
+    std::lock_guard<std::mutex> lock(fgEnumMutex);
+    for (std::size_t i = 0; i < fColumns.size(); ++i) {
+        const Column& column = fColumns[i];
+        schema << "    {\"name\": " << JsonString(column.name)
+               << ", \"dtype\": " << JsonString(TypeName(column.type))
+               << ", \"file\": " << JsonString(column.name + ".bin");
+        if (fCompress) schema << ", \"compression\": \"zlib\"";
+        if (column.type == kEnum8) {
+            schema << ", \"labels\": [";
+            auto it = fgEnumLabels.find(fName + "/" + column.name);
+            if (it != fgEnumLabels.end()) {
+                for (std::size_t l = 0; l < it->second.size(); ++l) {
+                    schema << (l ? ", " : "") << JsonString(it->second[l]);
+                }
+            }
+            schema << "], \"other_code\": " << G4int(kOtherCode);
+        }
+        schema << "}" << (i + 1 < fColumns.size() ? "," : "") << "\n";
+    }
+    schema << "  ]\n}\n";
+}
+
+// ------------------------------------------------------------
+// Tipos
+// ------------------------------------------------------------
+std::size_t ColumnarWriter::TypeSize(ColumnType type)
+{
+    switch (type) {
+        case kInt32:   return sizeof(std::int32_t);
+        case kFloat32: return sizeof(float);
+        case kEnum8:   return sizeof(std::uint8_t);
+    }
+    return 1;
+}
+
+G4String ColumnarWriter::TypeName(ColumnType type)
+{
+    switch (type) {
+        case kInt32:   return ByteOrder() + G4String("i4");
+        case kFloat32: return ByteOrder() + G4String("f4");
+        case kEnum8:   return "|u1";
+    }
+    return "|u1";
+}
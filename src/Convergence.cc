@@ -0,0 +1,86 @@
+#include "Convergence.hh"
+#include "ConvergenceMessenger.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+Convergence::Convergence()
+{
+    fMessenger = new ConvergenceMessenger(this);
+}
+
+Convergence::~Convergence()
+{
+    delete fMessenger;
+}
+
+// ------------------------------------------------------------
+// Error del conteo elegido
+// ------------------------------------------------------------
+// Misma estimación que <archivo>_tallies.csv: sqrt(Σx² - (Σx)²/N) / Σx.
+// Una banda que no existe (más que las de /tally/bands) usa los detectados.
+G4double Convergence::GetRelativeError(const RunAction::Tallies& tallies) const
+{
+    G4double sum = tallies.detected;
+    G4double sumSq = tallies.detectedSq;
+    if (fTally >= 0 && fTally < G4int(tallies.bands.size())) {
+        sum = tallies.bands[fTally];
+        sumSq = tallies.bandsSq[fTally];
+    }
+    if (sum <= 0. || tallies.events <= 0) return 0.;
+    return std::sqrt(std::max(0., sumSq - sum*sum/tallies.events)) / sum;
+}
+
+// ------------------------------------------------------------
+// Próximo lote
+// ------------------------------------------------------------
+G4int Convergence::NextBatch(const RunAction::Tallies& tallies, G4int maxEvents)
+{
+    G4int done = tallies.events;
+    G4int remaining = maxEvents - done;
+    if (!IsActive()) return std::max(0, remaining);
+
+    G4double relative = GetRelativeError(tallies);
+    if (fTarget > 0. && relative > 0. && relative <= fTarget) {
+        fReason = "error";
+        return 0;
+    }
+    if (fMaxTime > 0. && tallies.time >= fMaxTime) {
+        fReason = "tiempo";
+        return 0;
+    }
+    if (remaining <= 0) {
+        fReason = "eventos";
+        return 0;
+    }
+
+    // Sin conteos todavía: un lote del tamaño base
+    G4double n = fBatch;
+    if (fTarget > 0. && relative > 0.) {
+        G4double needed = done * (relative/fTarget) * (relative/fTarget);
+        n = std::clamp(1.1*needed - done, G4double(fBatch), G4double(std::max(done, fBatch)));
+    }
+    // Lo que entra en el presupuesto al ritmo medido
+    if (fMaxTime > 0. && done > 0 && tallies.time > 0.) {
+        n = std::min(n, std::max(1., (fMaxTime - tallies.time) * done / tallies.time));
+    }
+    return G4int(std::min(n, G4double(remaining)));
+}
+
+void Convergence::Print(const RunAction::Tallies& tallies) const
+{
+    if (!IsActive()) return;
+
+    static const std::map<G4String, G4String> reasons = {
+        {"error", "error alcanzado"}, {"tiempo", "presupuesto de tiempo"}, {"eventos", "máximo de eventos"}};
+    auto reason = reasons.find(fReason);
+    G4cout << "  Convergencia:             " << tallies.events << " eventos, error relativo "
+           << GetRelativeError(tallies);
+    if (fTarget > 0.) G4cout << " (objetivo " << fTarget << ")";
+    if (reason != reasons.end()) G4cout << "; parada por " << reason->second;
+    G4cout << G4endl;
+}
@@ -0,0 +1,82 @@
+#include "ConvergenceMessenger.hh"
+#include "Convergence.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4SystemOfUnits.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /convergence/
+// ------------------------------------------------------------
+ConvergenceMessenger::ConvergenceMessenger(Convergence* convergence)
+ : fConvergence(convergence)
+{
+    // Los lotes se lanzan desde el master
+    fConvergenceDir = new G4UIdirectory("/convergence/", false);
+    fConvergenceDir->SetGuidance("Largo de run adaptativo para /driver/beamOn y /detector/sweep/run.");
+
+    fTargetCmd = new G4UIcmdWithADouble("/convergence/targetError", this);
+    fTargetCmd->SetGuidance("Error relativo objetivo del conteo elegido (0: sin objetivo).");
+    fTargetCmd->SetGuidance("El número de eventos pedido pasa a ser un máximo.");
+    fTargetCmd->SetParameterName("error", false);
+    fTargetCmd->SetRange("error >= 0.");
+    fTargetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTargetCmd->SetToBeBroadcasted(false);
+
+    fTallyCmd = new G4UIcmdWithAnInteger("/convergence/tally", this);
+    fTallyCmd->SetGuidance("Banda de /tally/bands a seguir (0: la de menor energía, por defecto);");
+    fTallyCmd->SetGuidance("-1: total de neutrones detectados.");
+    fTallyCmd->SetParameterName("band", false);
+    fTallyCmd->SetRange("band >= -1");
+    fTallyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fTallyCmd->SetToBeBroadcasted(false);
+
+    fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/convergence/maxTime", this);
+    fMaxTimeCmd->SetGuidance("Presupuesto de tiempo de run por punto (0: sin límite).");
+    fMaxTimeCmd->SetParameterName("time", false);
+    fMaxTimeCmd->SetRange("time >= 0.");
+    fMaxTimeCmd->SetUnitCategory("Time");
+    fMaxTimeCmd->SetDefaultUnit("s");
+    fMaxTimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMaxTimeCmd->SetToBeBroadcasted(false);
+
+    fBatchCmd = new G4UIcmdWithAnInteger("/convergence/batch", this);
+    fBatchCmd->SetGuidance("Eventos del primer lote y tamaño mínimo de los siguientes (por defecto 10000).");
+    fBatchCmd->SetParameterName("events", false);
+    fBatchCmd->SetRange("events > 0");
+    fBatchCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fBatchCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+ConvergenceMessenger::~ConvergenceMessenger()
+{
+    delete fTargetCmd;
+    delete fTallyCmd;
+    delete fMaxTimeCmd;
+    delete fBatchCmd;
+    delete fConvergenceDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con Convergence
+// ------------------------------------------------------------
+void ConvergenceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fTargetCmd) {
+        fConvergence->SetTargetError(fTargetCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fTallyCmd) {
+        fConvergence->SetTally(fTallyCmd->GetNewIntValue(newValue));
+    }
+    else if (command == fMaxTimeCmd) {
+        fConvergence->SetMaxTime(fMaxTimeCmd->GetNewDoubleValue(newValue)/s);
+    }
+    else if (command == fBatchCmd) {
+        fConvergence->SetBatch(fBatchCmd->GetNewIntValue(newValue));
+    }
+}
@@ -0,0 +1,207 @@
+#include "DepthPlanes.hh"
+#include "DepthPlanesMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4Neutron.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+const G4String DepthPlanes::kName = "DepthPlanes";
+
+namespace {
+
+constexpr G4double kLog10EMin = -3.;   // log10(E/eV)
+constexpr G4double kBinsPerDecade = 10.;
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+DepthPlanes::DepthPlanes()
+ : G4VAccumulable(kName)
+{
+    fMessenger = new DepthPlanesMessenger(this);
+}
+
+DepthPlanes::~DepthPlanes()
+{
+    delete fMessenger;
+}
+
+// ------------------------------------------------------------
+// Configuración
+// ------------------------------------------------------------
+G4bool DepthPlanes::SetDepths(const std::vector<G4double>& depths)
+{
+    if (G4int(depths.size()) > kMaxPlanes) return false;
+    for (std::size_t k = 0; k < depths.size(); ++k) {
+        if (depths[k] <= 0. || (k > 0 && depths[k] <= depths[k - 1])) return false;
+    }
+    fDepths = depths;
+    return true;
+}
+
+void DepthPlanes::SetGeometry(G4double halfZ, const std::vector<G4double>& bandEdges)
+{
+    // Sólo los planos dentro del bloque (el último puede ser la cara trasera)
+    fHalfZ = halfZ;
+    fZ.clear();
+    for (G4double depth : fDepths) {
+        if (depth <= 2.*halfZ) fZ.push_back(depth - halfZ);
+    }
+    fBandEdges = bandEdges;
+    fNumberOfBands = G4int(bandEdges.size()) + 1;
+
+    // Los hilos y el master reciben los mismos comandos: los tamaños coinciden
+    std::size_t size = fZ.size()*fNumberOfBands;
+    if (fSum.size() != size) {
+        fSum.assign(size, 0.);
+        fSumSq.assign(size, 0.);
+        fEvent.assign(size, 0.);
+        fTouched.clear();
+    }
+    fSpectrum.assign(fZ.size()*kSpectrumBins, 0.);
+}
+
+// ------------------------------------------------------------
+// Llenado
+// ------------------------------------------------------------
+void DepthPlanes::Score(const G4Track* track, const G4ThreeVector& a, const G4ThreeVector& b,
+                        G4double kineticEnergy, G4double weight)
+{
+    // Las trazas se siguen una a la vez: un ID nuevo es un neutrón nuevo,
+    // que empieza con los planos que su madre ya había cruzado
+    if (track->GetTrackID() != fTrackID) {
+        fTrackID = track->GetTrackID();
+        auto info = dynamic_cast<const PlaneCrossings*>(track->GetUserInformation());
+        fCrossed = info ? info->fCrossed : 0;
+    }
+
+    // Sólo cruces hacia adelante: planos con a.z < z <= b.z
+    if (b.z() <= a.z()) return;
+    auto first = std::upper_bound(fZ.begin(), fZ.end(), a.z());
+    auto last = std::upper_bound(first, fZ.end(), b.z());
+    if (first == last) return;
+
+    G4int band = std::upper_bound(fBandEdges.begin(), fBandEdges.end(), kineticEnergy)
+                 - fBandEdges.begin();
+    G4int bin = (kineticEnergy > 0.)
+        ? G4int(std::floor((std::log10(kineticEnergy/eV) - kLog10EMin)*kBinsPerDecade)) : -1;
+
+    for (auto it = first; it != last; ++it) {
+        G4int k = G4int(it - fZ.begin());
+        std::uint64_t bit = std::uint64_t(1) << k;
+        if (fFirstCrossing && (fCrossed & bit)) continue;
+        fCrossed |= bit;
+
+        if (fAperture > 0.) {
+            G4double t = (*it - a.z()) / (b.z() - a.z());
+            G4ThreeVector p = a + t*(b - a);
+            if (std::abs(p.x()) > fAperture || std::abs(p.y()) > fAperture) continue;
+        }
+
+        std::size_t index = std::size_t(k)*fNumberOfBands + band;
+        if (fEvent[index] == 0.) fTouched.push_back(index);
+        fEvent[index] += weight;
+        if (bin >= 0 && bin < kSpectrumBins) fSpectrum[std::size_t(k)*kSpectrumBins + bin] += weight;
+    }
+}
+
+// Los secundarios se crean en el mismo paso (división en una frontera de
+// importancia o colisión) y se siguen después de la madre, así que se
+// copia la máscara de este momento
+void DepthPlanes::PassToSecondaries(const G4Step* step) const
+{
+    if (!fFirstCrossing || fCrossed == 0) return;
+    for (const G4Track* secondary : *step->GetSecondaryInCurrentStep()) {
+        if (secondary->GetDefinition() != G4Neutron::Definition()) continue;
+        auto info = dynamic_cast<PlaneCrossings*>(secondary->GetUserInformation());
+        if (info) info->fCrossed = fCrossed;
+        else      secondary->SetUserInformation(new PlaneCrossings(fCrossed));
+    }
+}
+
+void DepthPlanes::EndOfEvent()
+{
+    for (std::size_t i : fTouched) {
+        G4double x = fEvent[i];
+        fSum[i] += x;
+        fSumSq[i] += x*x;
+        fEvent[i] = 0.;
+    }
+    fTouched.clear();
+    fTrackID = -1;
+}
+
+// ------------------------------------------------------------
+// G4VAccumulable
+// ------------------------------------------------------------
+void DepthPlanes::Merge(const G4VAccumulable& other)
+{
+    const auto& planes = static_cast<const DepthPlanes&>(other);
+    if (planes.fSum.size() != fSum.size()) return;
+    for (std::size_t i = 0; i < fSum.size(); ++i) {
+        fSum[i] += planes.fSum[i];
+        fSumSq[i] += planes.fSumSq[i];
+    }
+    for (std::size_t i = 0; i < fSpectrum.size(); ++i) fSpectrum[i] += planes.fSpectrum[i];
+}
+
+void DepthPlanes::Reset()
+{
+    std::fill(fSum.begin(), fSum.end(), 0.);
+    std::fill(fSumSq.begin(), fSumSq.end(), 0.);
+    std::fill(fEvent.begin(), fEvent.end(), 0.);
+    std::fill(fSpectrum.begin(), fSpectrum.end(), 0.);
+    fTouched.clear();
+    fTrackID = -1;
+}
+
+// ------------------------------------------------------------
+// Salida
+// ------------------------------------------------------------
+void DepthPlanes::Write(const G4String& base, G4int nEvents,
+                        const std::vector<G4String>& bandLabels) const
+{
+    if (fZ.empty() || nEvents <= 0) return;
+
+    // Formato largo (una fila por plano y banda), cómodo para pandas
+    std::ofstream csv(base + "_planes.csv");
+    csv << "# Eventos: " << nEvents << "\n";
+    csv << "Profundidad_cm,Banda,PorEvento,ErrorPorEvento,Fraccion\n";
+    for (std::size_t k = 0; k < fZ.size(); ++k) {
+        G4double total = 0.;
+        for (G4int b = 0; b < fNumberOfBands; ++b) total += fSum[k*fNumberOfBands + b];
+        for (G4int b = 0; b < fNumberOfBands; ++b) {
+            G4double sum = fSum[k*fNumberOfBands + b];
+            G4double sigma = std::sqrt(std::max(0., fSumSq[k*fNumberOfBands + b] - sum*sum/nEvents));
+            csv << (fZ[k] + fHalfZ)/cm << "," << bandLabels[b] << "," << sum/nEvents << ","
+                << sigma/nEvents << "," << (total > 0. ? sum/total : 0.) << "\n";
+        }
+    }
+
+    std::ofstream spectra(base + "_planes_spectra.csv");
+    spectra << "# Eventos: " << nEvents << "\n";
+    spectra << "Profundidad_cm,Emin_eV,Emax_eV,PorEvento\n";
+    for (std::size_t k = 0; k < fZ.size(); ++k) {
+        for (G4int i = 0; i < kSpectrumBins; ++i) {
+            spectra << (fZ[k] + fHalfZ)/cm << ","
+                    << std::pow(10., kLog10EMin + i/kBinsPerDecade) << ","
+                    << std::pow(10., kLog10EMin + (i + 1)/kBinsPerDecade) << ","
+                    << fSpectrum[k*kSpectrumBins + i]/nEvents << "\n";
+        }
+    }
+
+    if (!csv || !spectra) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir " << base << "_planes*.csv";
+        G4Exception("DepthPlanes::Write", "Planes001", JustWarning, ed);
+        return;
+    }
+    G4cout << "  Planos de profundidad:    " << fZ.size() << " en '" << base << "_planes.csv'" << G4endl;
+}
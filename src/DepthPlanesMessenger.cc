@@ -0,0 +1,120 @@
+#include "DepthPlanesMessenger.hh"
+#include "DepthPlanes.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+#include <vector>
+
+// ------------------------------------------------------------
+// Constructor: comandos /planes/
+// ------------------------------------------------------------
+DepthPlanesMessenger::DepthPlanesMessenger(DepthPlanes* planes)
+ : fPlanes(planes)
+{
+    fPlanesDir = new G4UIdirectory("/planes/");
+    fPlanesDir->SetGuidance("Planos de puntaje a varias profundidades dentro del bloque.");
+
+    fDepthsCmd = new G4UIcmdWithAString("/planes/depths", this);
+    fDepthsCmd->SetGuidance("Profundidades desde la cara de entrada, en orden creciente, y la unidad");
+    fDepthsCmd->SetGuidance("(como máximo 64; sin profundidades no hay planos, por defecto).");
+    fDepthsCmd->SetGuidance("Salida: <nombre>_planes.csv y <nombre>_planes_spectra.csv.");
+    fDepthsCmd->SetParameterName("depths", false);
+    fDepthsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fUniformCmd = new G4UIcommand("/planes/uniform", this);
+    fUniformCmd->SetGuidance("N planos cada 'step': profundidades step, 2·step, ..., N·step.");
+    auto nPrm = new G4UIparameter("n", 'i', false);
+    nPrm->SetParameterRange("n >= 0");
+    fUniformCmd->SetParameter(nPrm);
+    auto stepPrm = new G4UIparameter("step", 'd', false);
+    stepPrm->SetParameterRange("step > 0.");
+    fUniformCmd->SetParameter(stepPrm);
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultValue("cm");
+    fUniformCmd->SetParameter(unitPrm);
+    fUniformCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fFirstCrossingCmd = new G4UIcmdWithABool("/planes/firstCrossing", this);
+    fFirstCrossingCmd->SetGuidance("true (por defecto): sólo el primer cruce de cada neutrón por cada plano,");
+    fFirstCrossingCmd->SetGuidance("equivalente a lo que sale de una placa de ese espesor; false: todos los");
+    fFirstCrossingCmd->SetGuidance("cruces hacia adelante (corriente en el bloque grueso).");
+    fFirstCrossingCmd->SetParameterName("first", true);
+    fFirstCrossingCmd->SetDefaultValue(true);
+    fFirstCrossingCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fApertureCmd = new G4UIcmdWithADoubleAndUnit("/planes/aperture", this);
+    fApertureCmd->SetGuidance("Media apertura cuadrada centrada en el eje (0: toda la cara del bloque).");
+    fApertureCmd->SetGuidance("1 cm reproduce la ventana del detector de 2x2 cm.");
+    fApertureCmd->SetParameterName("halfWidth", false);
+    fApertureCmd->SetRange("halfWidth >= 0.");
+    fApertureCmd->SetUnitCategory("Length");
+    fApertureCmd->SetDefaultUnit("cm");
+    fApertureCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+DepthPlanesMessenger::~DepthPlanesMessenger()
+{
+    delete fDepthsCmd;
+    delete fUniformCmd;
+    delete fFirstCrossingCmd;
+    delete fApertureCmd;
+    delete fPlanesDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con DepthPlanes
+// ------------------------------------------------------------
+void DepthPlanesMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    std::istringstream is(newValue);
+    std::vector<G4double> depths;
+
+    if (command == fDepthsCmd) {
+        // "d1 d2 ... unidad": como /tally/bands
+        std::vector<G4String> tokens;
+        G4String token;
+        while (is >> token) tokens.push_back(token);
+        G4String unitName = tokens.back();
+        tokens.pop_back();
+        if (G4UnitDefinition::GetCategory(unitName) != "Length") {
+            G4ExceptionDescription ed;
+            ed << "Falta la unidad de longitud en /planes/depths " << newValue;
+            G4Exception("DepthPlanesMessenger::SetNewValue", "Planes002", JustWarning, ed);
+            return;
+        }
+        G4double unit = G4UIcommand::ValueOf(unitName);
+        for (const auto& t : tokens) depths.push_back(G4UIcommand::ConvertToDouble(t) * unit);
+    }
+    else if (command == fUniformCmd) {
+        G4int n;
+        G4double step;
+        G4String unitName;
+        is >> n >> step >> unitName;
+        for (G4int k = 1; k <= n; ++k) depths.push_back(k * step * G4UIcommand::ValueOf(unitName));
+    }
+    else if (command == fFirstCrossingCmd) {
+        fPlanes->SetFirstCrossing(fFirstCrossingCmd->GetNewBoolValue(newValue));
+        return;
+    }
+    else if (command == fApertureCmd) {
+        fPlanes->SetAperture(fApertureCmd->GetNewDoubleValue(newValue));
+        return;
+    }
+
+    if (!fPlanes->SetDepths(depths)) {
+        G4ExceptionDescription ed;
+        ed << "Profundidades inválidas: '" << newValue << "'. Deben ser positivas, crecientes"
+           << " y como máximo " << DepthPlanes::kMaxPlanes << ".";
+        G4Exception("DepthPlanesMessenger::SetNewValue", "Planes003", JustWarning, ed);
+    }
+}
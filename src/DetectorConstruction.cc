@@ -1,21 +1,35 @@
 #include "DetectorConstruction.hh"
 #include "DetectorMessenger.hh"
 #include "TransmittedSD.hh"
+#include "FluxSD.hh"
+#include "ImportanceWorld.hh"
 
 #include "G4Material.hh"
 #include "G4NistManager.hh"
 #include "G4Box.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
 #include "G4SDManager.hh"
-#include "G4LogicalVolumeStore.hh"
 #include "G4RegionStore.hh"
 #include "G4ProductionCuts.hh"
 #include "G4Region.hh"
 #include "G4UserLimits.hh"
 #include "G4VisAttributes.hh"
+#include "G4RunManager.hh"
+#include "G4Timer.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <algorithm>
+
+namespace {
+const G4double kWorldHalf = 20*cm;
+// Geometría fija del detector plano
+const G4double kDetHalfXY = 1*cm;
+const G4double kDetHalfZ = 0.5*mm;
+const G4double kDetGap   = 0.1*cm;   // separación parafina-detector
+}
+
 // ------------------------------------------------------------
 // Constructor
 // ------------------------------------------------------------
@@ -24,8 +38,27 @@ DetectorConstruction::DetectorConstruction()
    fParaffinX(5*cm/2),
    fParaffinY(5*cm/2),
    fParaffinZ(5*cm/2),
-   fMessenger(nullptr)
+   fMessenger(nullptr),
+   fSolidBlock(nullptr),
+   fPhysDetector(nullptr),
+   fSolidBlockExit(nullptr),
+   fPhysBlockExit(nullptr),
+   fPixels{0, 0},
+   fPixelPitch(0.5*cm),
+   fLogicPixel(nullptr),
+   fBoundaryMargin(2*mm),
+   fImportanceWorld(nullptr),
+   fThermalScattering(false),
+   fConstructionTime(0.)
 {
+    // Por defecto no hay límite de paso; "fixed" usa 0.01 mm como antes
+    for (G4int i = 0; i < kNumStepLimitVolumes; ++i) {
+        fStepPolicy[i] = kNoStepLimit;
+        fMaxStep[i] = 0.01*mm;
+        fStepLimits[i] = new G4UserLimits(fMaxStep[i]);
+        fLogicVolume[i] = nullptr;
+        fLogicLayer[i] = nullptr;
+    }
     fMessenger = new DetectorMessenger(this);
 }
 
@@ -35,6 +68,7 @@ DetectorConstruction::DetectorConstruction()
 DetectorConstruction::~DetectorConstruction()
 {
     delete fMessenger;
+    for (auto limits : fStepLimits) delete limits;
 }
 
 // ------------------------------------------------------------
@@ -42,42 +76,88 @@ DetectorConstruction::~DetectorConstruction()
 // ------------------------------------------------------------
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
+    G4Timer timer;
+    timer.Start();
+
     auto nist = G4NistManager::Instance();
 
     // --- Mundo ---
     G4Material* worldMat = nist->FindOrBuildMaterial("G4_AIR");
-    auto solidWorld = new G4Box("World", 20*cm, 20*cm, 20*cm);
+    auto solidWorld = new G4Box("World", kWorldHalf, kWorldHalf, kWorldHalf);
     auto logicWorld = new G4LogicalVolume(solidWorld, worldMat, "World");
     auto physWorld  = new G4PVPlacement(0, {}, logicWorld, "World", 0, false, 0);
 
     // --- Bloque de parafina (moderador) ---
+    // Con dispersión térmica el hidrógeno es el del polietileno (CH2), la
+    // tabla S(α,β) más cercana a la parafina en los datos de Geant4
     G4Material* paraffin = G4Material::GetMaterial("Paraffin");
     if (!paraffin) {
+        G4Element* hydrogen = nist->FindOrBuildElement("H");
+        if (fThermalScattering) {
+            hydrogen = new G4Element("TS_H_of_Polyethylene", "H_POLY", 1., 1.0079*g/mole);
+        }
         paraffin = new G4Material("Paraffin", 0.93*g/cm3, 2);
         paraffin->AddElement(nist->FindOrBuildElement("C"), 1);
-        paraffin->AddElement(nist->FindOrBuildElement("H"), 2);
+        paraffin->AddElement(hydrogen, 2);
     }
 
-    auto solidBlock = new G4Box("Block", fParaffinX, fParaffinY, fParaffinZ);
-    auto logicBlock = new G4LogicalVolume(solidBlock, paraffin, "Block");
+    fSolidBlock = new G4Box("Block", fParaffinX, fParaffinY, fParaffinZ);
+    auto logicBlock = new G4LogicalVolume(fSolidBlock, paraffin, "Block");
     new G4PVPlacement(0, G4ThreeVector(0,0,0), logicBlock, "Block", logicWorld, false, 0);
 
+    // Capa de salida del bloque: sólo existe con la política "boundary"
+    fSolidBlockExit = nullptr;
+    fPhysBlockExit = nullptr;
+    fLogicLayer[kBlockVolume] = nullptr;
+    if (fStepPolicy[kBlockVolume] == kBoundaryStepLimit) {
+        fSolidBlockExit = new G4Box("BlockExit", fParaffinX, fParaffinY, GetBlockExitHalfZ());
+        auto logicExit = new G4LogicalVolume(fSolidBlockExit, paraffin, "BlockExit");
+        fPhysBlockExit = new G4PVPlacement(0, G4ThreeVector(0,0,fParaffinZ - GetBlockExitHalfZ()),
+                                           logicExit, "BlockExit", logicBlock, false, 0);
+        fLogicLayer[kBlockVolume] = logicExit;
+    }
+
     // --- Detector plano ---
-    G4double detHalfX = 1*cm, detHalfY = 1*cm;
-    G4double detHalfZ = 0.5*mm;
+    G4ThreeVector detHalf = GetDetectorHalfSize();
+    G4double detHalfX = detHalf.x(), detHalfY = detHalf.y();
     auto detMat = nist->FindOrBuildMaterial("G4_AIR");
-    auto solidDet = new G4Box("Detector", detHalfX, detHalfY, detHalfZ);
+    auto solidDet = new G4Box("Detector", detHalfX, detHalfY, kDetHalfZ);
     auto logicDet = new G4LogicalVolume(solidDet, detMat, "Detector");
 
-    // Posición del detector justo después de la parafina
-    G4double zPos = fParaffinZ + 0.1*cm + detHalfZ;
-    new G4PVPlacement(0, G4ThreeVector(0,0,zPos), logicDet, "Detector", logicWorld, false, 0);
+    // Matriz de píxeles: el detector se llena con columnas replicadas en x
+    // y cada columna con píxeles replicados en y. El píxel de un hit sale
+    // de los números de copia (iy, ix) sin buscar en la geometría.
+    fLogicPixel = nullptr;
+    if (fPixels[0] > 0) {
+        auto solidColumn = new G4Box("PixelColumn", 0.5*fPixelPitch, detHalfY, kDetHalfZ);
+        auto logicColumn = new G4LogicalVolume(solidColumn, detMat, "PixelColumn");
+        new G4PVReplica("PixelColumn", logicColumn, logicDet, kXAxis, fPixels[0], fPixelPitch);
+        auto solidPixel = new G4Box("Pixel", 0.5*fPixelPitch, 0.5*fPixelPitch, kDetHalfZ);
+        fLogicPixel = new G4LogicalVolume(solidPixel, detMat, "Pixel");
+        new G4PVReplica("Pixel", fLogicPixel, logicColumn, kYAxis, fPixels[1], fPixelPitch);
+    }
+
+    // Posición del detector justo después de la parafina. Con la política
+    // "boundary" en el mundo, el detector va dentro de una capa de aire
+    // ("DetectorGuard") que es la única parte del mundo con límite de paso.
+    G4ThreeVector detPos(0, 0, GetDetectorZ());
+    fLogicLayer[kWorldVolume] = nullptr;
+    if (fStepPolicy[kWorldVolume] == kBoundaryStepLimit) {
+        auto solidGuard = new G4Box("DetectorGuard", detHalfX + fBoundaryMargin,
+                                    detHalfY + fBoundaryMargin, GetGuardHalfZ());
+        auto logicGuard = new G4LogicalVolume(solidGuard, worldMat, "DetectorGuard");
+        fPhysDetector = new G4PVPlacement(0, detPos, logicGuard, "DetectorGuard", logicWorld, false, 0);
+        new G4PVPlacement(0, G4ThreeVector(), logicDet, "Detector", logicGuard, false, 0);
+        fLogicLayer[kWorldVolume] = logicGuard;
+    } else {
+        fPhysDetector = new G4PVPlacement(0, detPos, logicDet, "Detector", logicWorld, false, 0);
+    }
 
     // --- Límites de paso ---
-    G4double maxStep = 0.01*mm;
-    logicWorld->SetUserLimits(new G4UserLimits(maxStep));
-    logicBlock->SetUserLimits(new G4UserLimits(maxStep));
-    logicDet->SetUserLimits(new G4UserLimits(maxStep));
+    fLogicVolume[kWorldVolume] = logicWorld;
+    fLogicVolume[kBlockVolume] = logicBlock;
+    fLogicVolume[kDetectorVolume] = logicDet;
+    ApplyStepLimits();
     logicWorld->SetVisAttributes(G4VisAttributes::GetInvisible());
 
     // --- Cortes de producción ---
@@ -95,9 +175,188 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
     region->AddRootLogicalVolume(logicBlock);
     region->AddRootLogicalVolume(logicDet);
 
+    timer.Stop();
+    fConstructionTime = timer.GetRealElapsed();
+
     return physWorld;
 }
 
+// ------------------------------------------------------------
+// Setters: antes de /run/initialize sólo guardan el valor; después
+// actualizan la geometría existente en el lugar
+// ------------------------------------------------------------
+void DetectorConstruction::SetParaffinX(G4double val)
+{
+    fParaffinX = val;
+    if (fSolidBlock) UpdateGeometry();
+}
+
+void DetectorConstruction::SetParaffinY(G4double val)
+{
+    fParaffinY = val;
+    if (fSolidBlock) UpdateGeometry();
+}
+
+void DetectorConstruction::SetParaffinZ(G4double val)
+{
+    fParaffinZ = val;
+    if (fSolidBlock) UpdateGeometry();
+}
+
+G4double DetectorConstruction::GetDetectorZ() const
+{
+    return fParaffinZ + kDetGap + kDetHalfZ;
+}
+
+G4ThreeVector DetectorConstruction::GetDetectorHalfSize() const
+{
+    if (fPixels[0] > 0) {
+        return G4ThreeVector(0.5*fPixels[0]*fPixelPitch, 0.5*fPixels[1]*fPixelPitch, kDetHalfZ);
+    }
+    return G4ThreeVector(kDetHalfXY, kDetHalfXY, kDetHalfZ);
+}
+
+G4bool DetectorConstruction::SetPixels(G4int nx, G4int ny, G4double pitch)
+{
+    if (nx < 0 || ny < 0 || pitch <= 0.) return false;
+    if (nx > 0 && (ny == 0 || 0.5*std::max(nx, ny)*pitch + fBoundaryMargin >= kWorldHalf)) return false;
+
+    G4bool changed = (nx != fPixels[0]) || (nx > 0 && (ny != fPixels[1] || pitch != fPixelPitch));
+    fPixels[0] = nx;
+    fPixels[1] = (nx > 0) ? ny : 0;
+    fPixelPitch = pitch;
+    if (fSolidBlock && changed) ReinitializeGeometry();
+    return true;
+}
+
+// La guarda no puede entrar en la parafina: como mucho llena el hueco
+G4double DetectorConstruction::GetGuardHalfZ() const
+{
+    return kDetHalfZ + std::min(fBoundaryMargin, kDetGap);
+}
+
+G4double DetectorConstruction::GetBlockExitHalfZ() const
+{
+    return 0.5*std::min(fBoundaryMargin, 2*fParaffinZ);
+}
+
+// ------------------------------------------------------------
+// Límites de paso
+// ------------------------------------------------------------
+// Los G4UserLimits sólo tienen efecto porque main.cc registra
+// G4StepLimiterPhysics en la lista de física.
+void DetectorConstruction::ApplyStepLimits()
+{
+    for (G4int i = 0; i < kNumStepLimitVolumes; ++i) {
+        if (!fLogicVolume[i]) continue;
+        fStepLimits[i]->SetMaxAllowedStep(fMaxStep[i]);
+
+        // "boundary" sin capa propia (el detector) limita todo el volumen
+        G4bool layer = (fStepPolicy[i] == kBoundaryStepLimit && fLogicLayer[i]);
+        G4bool whole = (fStepPolicy[i] == kFixedStepLimit) ||
+                       (fStepPolicy[i] == kBoundaryStepLimit && !fLogicLayer[i]);
+
+        fLogicVolume[i]->SetUserLimits(whole ? fStepLimits[i] : nullptr);
+        if (fLogicLayer[i]) fLogicLayer[i]->SetUserLimits(layer ? fStepLimits[i] : nullptr);
+    }
+
+    // Los píxeles llenan el detector: llevan su mismo límite
+    if (fLogicPixel) fLogicPixel->SetUserLimits(fLogicVolume[kDetectorVolume]->GetUserLimits());
+}
+
+void DetectorConstruction::SetStepLimitPolicy(StepLimitVolume volume, StepLimitPolicy policy)
+{
+    // Entrar o salir de "boundary" agrega o quita capas en el mundo o el bloque
+    G4bool structural = (volume != kDetectorVolume) &&
+        ((policy == kBoundaryStepLimit) != (fStepPolicy[volume] == kBoundaryStepLimit));
+    fStepPolicy[volume] = policy;
+
+    if (!fSolidBlock) return;  // todavía no hay geometría
+    if (structural) ReinitializeGeometry();
+    else            ApplyStepLimits();
+}
+
+void DetectorConstruction::SetMaxStep(StepLimitVolume volume, G4double val)
+{
+    fMaxStep[volume] = val;
+    if (fSolidBlock) ApplyStepLimits();
+}
+
+void DetectorConstruction::SetBoundaryMargin(G4double val)
+{
+    fBoundaryMargin = val;
+    if (!fSolidBlock) return;
+    if (fStepPolicy[kWorldVolume] == kBoundaryStepLimit ||
+        fStepPolicy[kBlockVolume] == kBoundaryStepLimit) {
+        ReinitializeGeometry();
+    }
+}
+
+G4String DetectorConstruction::GetStepLimitPolicyName(StepLimitPolicy policy)
+{
+    switch (policy) {
+        case kFixedStepLimit:    return "fixed";
+        case kBoundaryStepLimit: return "boundary";
+        default:                 return "none";
+    }
+}
+
+// ------------------------------------------------------------
+// Muestreo por importancia
+// ------------------------------------------------------------
+void DetectorConstruction::SetImportanceWorld(ImportanceWorld* world)
+{
+    fImportanceWorld = world;
+    RegisterParallelWorld(world);
+}
+
+// ------------------------------------------------------------
+// Reconstrucción completa (cambios de estructura, no de tamaño)
+// ------------------------------------------------------------
+// Geant4 destruye los volúmenes ahora y llama de nuevo a Construct() al
+// inicio del siguiente run; hasta entonces no hay geometría que actualizar.
+void DetectorConstruction::ReinitializeGeometry()
+{
+    G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+    fSolidBlock = nullptr;
+    fPhysDetector = nullptr;
+    fSolidBlockExit = nullptr;
+    fPhysBlockExit = nullptr;
+    fLogicPixel = nullptr;
+    for (G4int i = 0; i < kNumStepLimitVolumes; ++i) {
+        fLogicVolume[i] = nullptr;
+        fLogicLayer[i] = nullptr;
+    }
+    if (fImportanceWorld) fImportanceWorld->ResetCells();
+}
+
+// ------------------------------------------------------------
+// Actualización de la geometría entre runs
+// ------------------------------------------------------------
+// Sólo cambian las dimensiones del sólido "Block" y la traslación del
+// detector: materiales, regiones y cortes no se tocan, así que las tablas
+// de física siguen siendo válidas. Geant4 vuelve a optimizar (voxelizar)
+// la geometría al inicio del siguiente run.
+void DetectorConstruction::UpdateGeometry()
+{
+    fSolidBlock->SetXHalfLength(fParaffinX);
+    fSolidBlock->SetYHalfLength(fParaffinY);
+    fSolidBlock->SetZHalfLength(fParaffinZ);
+    fPhysDetector->SetTranslation(G4ThreeVector(0, 0, GetDetectorZ()));
+
+    if (fSolidBlockExit) {
+        fSolidBlockExit->SetXHalfLength(fParaffinX);
+        fSolidBlockExit->SetYHalfLength(fParaffinY);
+        fSolidBlockExit->SetZHalfLength(GetBlockExitHalfZ());
+        fPhysBlockExit->SetTranslation(G4ThreeVector(0, 0, fParaffinZ - GetBlockExitHalfZ()));
+    }
+
+    // Las celdas de importancia siguen el espesor del bloque
+    if (fImportanceWorld) fImportanceWorld->UpdateGeometry();
+
+    G4RunManager::GetRunManager()->GeometryHasBeenModified();
+}
+
 // ------------------------------------------------------------
 // Detector sensible
 // ------------------------------------------------------------
@@ -114,6 +373,19 @@ void DetectorConstruction::ConstructSDandField()
         sd = static_cast<TransmittedSD*>(existingSD);
     }
 
-    auto lv = G4LogicalVolumeStore::GetInstance()->GetVolume("Detector");
-    if (lv) lv->SetSensitiveDetector(sd);
+    // Se ejecuta en cada hilo de trabajo: cada uno tiene su propio SD.
+    // Con matriz de píxeles el SD va en los píxeles (llenan el detector).
+    sd->SetPixelColumns(fPixels[0]);
+    if (fLogicPixel) SetSensitiveDetector(fLogicPixel, sd);
+    else             SetSensitiveDetector("Detector", sd);
+
+    // Malla de flujo (/flux/): el SD está siempre y no hace nada si la
+    // malla está desactivada. La capa de salida es hija del bloque.
+    auto fluxSD = sdman->FindSensitiveDetector("FluxSD", false);
+    if (!fluxSD) {
+        fluxSD = new FluxSD("FluxSD");
+        sdman->AddNewDetector(fluxSD);
+    }
+    SetSensitiveDetector("Block", fluxSD);
+    if (fLogicLayer[kBlockVolume]) SetSensitiveDetector(fLogicLayer[kBlockVolume], fluxSD);
 }
@@ -1,18 +1,40 @@
 #include "DetectorMessenger.hh"
 #include "DetectorConstruction.hh"
 
+#include "StepLimitComparison.hh"
+
 #include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
 #include "G4UIdirectory.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <sstream>
+#include <vector>
+
+namespace {
+
+// Volúmenes afectados por un nombre de comando ("all" = todos)
+std::vector<StepLimitVolume> VolumesFromName(const G4String& name)
+{
+    if (name == "world")    return {kWorldVolume};
+    if (name == "block")    return {kBlockVolume};
+    if (name == "detector") return {kDetectorVolume};
+    return {kWorldVolume, kBlockVolume, kDetectorVolume};
+}
+
+}
+
 // ------------------------------------------------------------
 // Constructor: define los comandos accesibles desde el macro
 // ------------------------------------------------------------
 DetectorMessenger::DetectorMessenger(DetectorConstruction* detector)
  : fDetector(detector)
 {
-    // Directorio principal de comandos
-    fDetectorDir = new G4UIdirectory("/detector/");
+    // Directorio principal de comandos (sólo existe en el master: no se
+    // reenvía a los hilos de trabajo en modo MT)
+    fDetectorDir = new G4UIdirectory("/detector/", false);
     fDetectorDir->SetGuidance("Comandos para configurar la geometría del detector.");
 
     // --- Comando para X ---
@@ -32,6 +54,70 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction* detector)
     fParaffinZCmd->SetGuidance("Define el tamaño medio (half-length) en Z (espesor) de la parafina.");
     fParaffinZCmd->SetParameterName("Z", false);
     fParaffinZCmd->SetUnitCategory("Length");
+
+    // --- Detector segmentado en píxeles ---
+    fPixelsCmd = new G4UIcommand("/detector/pixels", this);
+    fPixelsCmd->SetGuidance("Construye el detector como una matriz de nx x ny píxeles cuadrados de lado");
+    fPixelsCmd->SetGuidance("pitch (réplicas), con conteos por píxel y banda en <nombre>_pixels.bin.");
+    fPixelsCmd->SetGuidance("nx = 0 vuelve al detector único de 2x2 cm. Reconstruye la geometría.");
+    auto nxPrm = new G4UIparameter("nx", 'i', false);
+    nxPrm->SetParameterRange("nx >= 0");
+    fPixelsCmd->SetParameter(nxPrm);
+    auto nyPrm = new G4UIparameter("ny", 'i', true);
+    nyPrm->SetDefaultValue(0);
+    nyPrm->SetParameterRange("ny >= 0");
+    fPixelsCmd->SetParameter(nyPrm);
+    auto pitchPrm = new G4UIparameter("pitch", 'd', true);
+    pitchPrm->SetDefaultValue(0.5);
+    pitchPrm->SetParameterRange("pitch > 0.");
+    fPixelsCmd->SetParameter(pitchPrm);
+    auto pitchUnitPrm = new G4UIparameter("unit", 's', true);
+    pitchUnitPrm->SetDefaultValue("cm");
+    fPixelsCmd->SetParameter(pitchUnitPrm);
+    fPixelsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fPixelsCmd->SetToBeBroadcasted(false);
+
+    // --- Límites de paso por volumen ---
+    fStepLimitDir = new G4UIdirectory("/detector/stepLimit/", false);
+    fStepLimitDir->SetGuidance("Políticas de límite de paso (G4StepLimiter) por volumen.");
+
+    fPolicyCmd = new G4UIcommand("/detector/stepLimit/policy", this);
+    fPolicyCmd->SetGuidance("Política de límite de paso de un volumen.");
+    fPolicyCmd->SetGuidance("  none: sin límite; fixed: en todo el volumen;");
+    fPolicyCmd->SetGuidance("  boundary: sólo en una capa junto al detector.");
+    auto volumePrm = new G4UIparameter("volume", 's', false);
+    volumePrm->SetParameterCandidates("world block detector all");
+    fPolicyCmd->SetParameter(volumePrm);
+    auto policyPrm = new G4UIparameter("policy", 's', false);
+    policyPrm->SetParameterCandidates("none fixed boundary");
+    fPolicyCmd->SetParameter(policyPrm);
+    fPolicyCmd->SetToBeBroadcasted(false);
+
+    fMaxStepCmd = new G4UIcommand("/detector/stepLimit/maxStep", this);
+    fMaxStepCmd->SetGuidance("Longitud máxima de paso de un volumen (políticas fixed y boundary).");
+    auto stepVolumePrm = new G4UIparameter("volume", 's', false);
+    stepVolumePrm->SetParameterCandidates("world block detector all");
+    fMaxStepCmd->SetParameter(stepVolumePrm);
+    auto valuePrm = new G4UIparameter("value", 'd', false);
+    valuePrm->SetParameterRange("value > 0.");
+    fMaxStepCmd->SetParameter(valuePrm);
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultValue("mm");
+    fMaxStepCmd->SetParameter(unitPrm);
+    fMaxStepCmd->SetToBeBroadcasted(false);
+
+    fMarginCmd = new G4UIcmdWithADoubleAndUnit("/detector/stepLimit/margin", this);
+    fMarginCmd->SetGuidance("Espesor de la capa junto al detector para la política boundary.");
+    fMarginCmd->SetParameterName("margin", false);
+    fMarginCmd->SetUnitCategory("Length");
+    fMarginCmd->SetToBeBroadcasted(false);
+
+    fCompareCmd = new G4UIcmdWithAnInteger("/detector/stepLimit/compare", this);
+    fCompareCmd->SetGuidance("Corre N eventos con cada política y compara eventos/s y espectro.");
+    fCompareCmd->SetParameterName("events", false);
+    fCompareCmd->SetRange("events > 0");
+    fCompareCmd->AvailableForStates(G4State_Idle);
+    fCompareCmd->SetToBeBroadcasted(false);
 }
 
 // ------------------------------------------------------------
@@ -42,6 +128,12 @@ DetectorMessenger::~DetectorMessenger()
     delete fParaffinXCmd;
     delete fParaffinYCmd;
     delete fParaffinZCmd;
+    delete fPixelsCmd;
+    delete fPolicyCmd;
+    delete fMaxStepCmd;
+    delete fMarginCmd;
+    delete fCompareCmd;
+    delete fStepLimitDir;
     delete fDetectorDir;
 }
 
@@ -59,4 +151,41 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
     else if (command == fParaffinZCmd) {
         fDetector->SetParaffinZ(fParaffinZCmd->GetNewDoubleValue(newValue));
     }
+    else if (command == fPixelsCmd) {
+        G4int nx, ny;
+        G4double pitch;
+        G4String unit;
+        std::istringstream is(newValue);
+        is >> nx >> ny >> pitch >> unit;
+        if (!fDetector->SetPixels(nx, ny > 0 ? ny : nx, pitch*G4UIcommand::ValueOf(unit))) {
+            G4ExceptionDescription ed;
+            ed << "Matriz de píxeles inválida: '" << newValue << "' (debe caber en el mundo).";
+            G4Exception("DetectorMessenger::SetNewValue", "Pixel002", JustWarning, ed);
+        }
+    }
+    else if (command == fPolicyCmd) {
+        G4String volume, policyName;
+        std::istringstream is(newValue);
+        is >> volume >> policyName;
+        StepLimitPolicy policy = kNoStepLimit;
+        if (policyName == "fixed")         policy = kFixedStepLimit;
+        else if (policyName == "boundary") policy = kBoundaryStepLimit;
+        for (auto v : VolumesFromName(volume)) fDetector->SetStepLimitPolicy(v, policy);
+    }
+    else if (command == fMaxStepCmd) {
+        G4String volume, unit;
+        G4double value;
+        std::istringstream is(newValue);
+        is >> volume >> value >> unit;
+        for (auto v : VolumesFromName(volume)) {
+            fDetector->SetMaxStep(v, value*G4UIcommand::ValueOf(unit));
+        }
+    }
+    else if (command == fMarginCmd) {
+        fDetector->SetBoundaryMargin(fMarginCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fCompareCmd) {
+        StepLimitComparison comparison(fDetector);
+        comparison.Run(fCompareCmd->GetNewIntValue(newValue));
+    }
 }
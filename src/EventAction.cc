@@ -1,12 +1,24 @@
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "TransmittedSD.hh"
+#include "ColumnarWriter.hh"
+#include "CollisionRecorder.hh"
+#include "StartupProfiler.hh"
 #include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4AnalysisManager.hh"
 
+#include <algorithm>
+
 EventAction::EventAction(RunAction* runAction)
  : G4UserEventAction(),
-   fRunAction(runAction)
+   fRunAction(runAction),
+   fHCID(-1),
+   fBandScore(RunAction::kMaxBands, 0.)
 {}
 
 EventAction::~EventAction() {}
@@ -17,13 +29,120 @@ void EventAction::BeginOfEventAction(const G4Event*)
     // Puedes usarlo para inicializar variables por evento si lo necesitas
 }
 
-void EventAction::EndOfEventAction(const G4Event*) 
+void EventAction::EndOfEventAction(const G4Event* event) 
+{
+    // Marca el fin del primer evento para el reporte de arranque
+    StartupProfiler::MarkEventEnd();
+
+    auto hce = event->GetHCofThisEvent();
+    if (fHCID < 0) {
+        fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(TransmittedSD::kHitsCollectionName);
+    }
+    auto hits = hce ? static_cast<TransmittedHitsCollection*>(hce->GetHC(fHCID)) : nullptr;
+    if (hits && hits->entries() > 0) FlushHits(event->GetEventID(), *hits);
+
+    // Historias de colisiones: se escriben las de los neutrones detectados y
+    // sus antecesores (y las muestreadas) y la arena del hilo se vacía para el próximo evento
+    CollisionRecorder* collisions = fRunAction->GetCollisionRecorder();
+    if (collisions->IsRecording()) {
+        fDetectedTracks.clear();
+        for (std::size_t i = 0; hits && i < hits->entries(); ++i) {
+            fDetectedTracks.emplace_back((*hits)[i]->GetTrackID(), (*hits)[i]->GetParentID());
+        }
+        collisions->EndOfEvent(event->GetEventID(), fDetectedTracks);
+    }
+}
+
+// ------------------------------------------------------------
+// Volcado de los hits del evento
+// ------------------------------------------------------------
+// Todo el llenado ocurre aquí, una vez por evento y fuera del bucle de
+// tracking: el SD sólo copia el estado del neutrón en un hit del pool.
+void EventAction::FlushHits(G4int eventID, const TransmittedHitsCollection& hits)
+{
+    auto analysisManager = G4AnalysisManager::Instance();
+    G4bool ntuple = fRunAction->IsNtupleEnabled();
+    ColumnarWriter* columnar = ntuple ? fRunAction->GetColumnarWriter() : nullptr;
+
+    std::fill(fBandScore.begin(), fBandScore.end(), 0.);
+    G4double detected = 0.;
+
+    for (std::size_t i = 0; i < hits.entries(); ++i) {
+        const TransmittedHit& hit = *hits[i];
+
+        // --- Espectros (pesados) y puntaje del evento por banda ---
+        G4double energy = hit.GetKineticEnergy();
+        G4double weight = hit.GetWeight();
+        analysisManager->FillH1(RunAction::kEnergyH1, energy / eV, weight);
+        analysisManager->FillH1(RunAction::kLogEnergyH1, energy, weight);
+        analysisManager->FillH2(RunAction::kEnergyTimeH2, energy, hit.GetGlobalTime(), weight);
+        analysisManager->FillH2(RunAction::kEnergyRadiusH2, energy, hit.GetPosition().perp(), weight);
+        G4int band = fRunAction->GetBand(energy);
+        fBandScore[band] += weight;
+        fRunAction->AddPixelScore(hit.GetPixel(), band, weight);
+        detected += weight;
+
+        // La ntuple por neutrón es opcional (/output/ntuple true)
+        if (!ntuple) continue;
+        if (columnar) FillColumnar(columnar, eventID, hit);
+        else          FillNtuple(eventID, hit);
+    }
+
+    // Conteos y sumas de cuadrados por evento (errores con pesos)
+    fRunAction->AddEventScore(fBandScore.data(), detected);
+}
+
+// Ntuple ROOT "NeutronTracks" (ID=0; columnas definidas en RunAction)
+void EventAction::FillNtuple(G4int eventID, const TransmittedHit& hit)
 {
-    // Este método se llama al final de cada evento
-    // Puedes usarlo para procesar "Hits Collections" si las usaras,
-    // pero para el llenado directo, lo dejamos vacío.
+    auto analysisManager = G4AnalysisManager::Instance();
+    const G4int ntupleID = 0;
+    const G4ThreeVector& pos = hit.GetPosition();
+    const G4ThreeVector& direction = hit.GetDirection();
+    const G4VProcess* process = hit.GetProcess();
+
+    analysisManager->FillNtupleIColumn(ntupleID, 0, eventID);
+    analysisManager->FillNtupleIColumn(ntupleID, 1, hit.GetTrackID());
+    analysisManager->FillNtupleIColumn(ntupleID, 2, hit.GetParentID());
+    analysisManager->FillNtupleDColumn(ntupleID, 3, hit.GetKineticEnergy() / eV);
+    analysisManager->FillNtupleDColumn(ntupleID, 4, hit.GetGlobalTime() / ns);
+    analysisManager->FillNtupleDColumn(ntupleID, 5, pos.x() / mm);
+    analysisManager->FillNtupleDColumn(ntupleID, 6, pos.y() / mm);
+    analysisManager->FillNtupleDColumn(ntupleID, 7, pos.z() / mm);
+    analysisManager->FillNtupleDColumn(ntupleID, 8, hit.GetTrackLength() / mm);
+    analysisManager->FillNtupleIColumn(ntupleID, 9, hit.GetStepNumber());
+    analysisManager->FillNtupleSColumn(ntupleID, 10, hit.GetVolume()->GetName());
+    analysisManager->FillNtupleSColumn(ntupleID, 11, process ? process->GetProcessName() : "N/A");
+    analysisManager->FillNtupleDColumn(ntupleID, 12, direction.x());
+    analysisManager->FillNtupleDColumn(ntupleID, 13, direction.y());
+    analysisManager->FillNtupleDColumn(ntupleID, 14, direction.z());
+    analysisManager->FillNtupleDColumn(ntupleID, 15, hit.GetWeight());
+    analysisManager->AddNtupleRow(ntupleID);
 }
 
-// La función RecordNeutronEnergy() se ha eliminado
-// porque TransmittedSD.cc ahora maneja el llenado
-// del histograma Y la ntuple.
\ No newline at end of file
+// Salida columnar (/output/format columnar): mismas columnas en float32,
+// con códigos para el volumen y el proceso
+void EventAction::FillColumnar(ColumnarWriter* columnar, G4int eventID, const TransmittedHit& hit)
+{
+    const G4ThreeVector& pos = hit.GetPosition();
+    const G4ThreeVector& direction = hit.GetDirection();
+    const G4VProcess* process = hit.GetProcess();
+
+    columnar->FillI(0, eventID);
+    columnar->FillI(1, hit.GetTrackID());
+    columnar->FillI(2, hit.GetParentID());
+    columnar->FillF(3, hit.GetKineticEnergy() / eV);
+    columnar->FillF(4, hit.GetGlobalTime() / ns);
+    columnar->FillF(5, pos.x() / mm);
+    columnar->FillF(6, pos.y() / mm);
+    columnar->FillF(7, pos.z() / mm);
+    columnar->FillF(8, hit.GetTrackLength() / mm);
+    columnar->FillI(9, hit.GetStepNumber());
+    columnar->FillEnum(10, hit.GetVolume()->GetName());
+    columnar->FillEnum(11, process ? process->GetProcessName() : G4String("N/A"));
+    columnar->FillF(12, direction.x());
+    columnar->FillF(13, direction.y());
+    columnar->FillF(14, direction.z());
+    columnar->FillF(15, hit.GetWeight());
+    columnar->AddRow();
+}
@@ -0,0 +1,51 @@
+#include "EventSeeder.hh"
+#include "SeedMessenger.hh"
+
+#include "G4Event.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "Randomize.hh"
+
+EventSeeder::EventSeeder()
+{
+    fMessenger = new SeedMessenger(this);
+}
+
+EventSeeder::~EventSeeder()
+{
+    delete fMessenger;
+}
+
+// Finalizador de SplitMix64: cambia la mitad de los bits de salida por
+// cada bit de entrada, así eventos vecinos no dan semillas parecidas
+std::uint64_t EventSeeder::Mix(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+void EventSeeder::Seed(const G4Event* event) const
+{
+    if (!fEnabled) return;
+
+    G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+    std::uint64_t h = Mix(std::uint64_t(fMasterSeed));
+    h = Mix(h ^ std::uint64_t(runID));
+    h = Mix(h ^ std::uint64_t(fEventOffset + event->GetEventID()));
+    std::uint64_t g = Mix(h);
+
+    // Cuatro semillas de 31 bits, distintas de cero (un cero termina la
+    // lista de semillas de los motores de CLHEP)
+    long seeds[5];
+    seeds[0] = long(h & 0x7fffffff);
+    seeds[1] = long((h >> 32) & 0x7fffffff);
+    seeds[2] = long(g & 0x7fffffff);
+    seeds[3] = long((g >> 32) & 0x7fffffff);
+    for (G4int i = 0; i < 4; ++i) {
+        if (seeds[i] == 0) seeds[i] = 1;
+    }
+    seeds[4] = 0;
+    G4Random::setTheSeeds(seeds);
+}
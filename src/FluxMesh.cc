@@ -0,0 +1,234 @@
+#include "FluxMesh.hh"
+#include "FluxMessenger.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+
+const G4String FluxMesh::kName = "FluxMesh";
+
+namespace {
+
+// Prefijo de orden de bytes de numpy para la máquina actual
+char ByteOrder()
+{
+    const std::uint16_t one = 1;
+    return (*reinterpret_cast<const char*>(&one) == 1) ? '<' : '>';
+}
+
+G4bool WriteFloats(const G4String& fileName, const std::vector<float>& values)
+{
+    std::ofstream out(fileName, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(float));
+    return bool(out);
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+FluxMesh::FluxMesh()
+ : G4VAccumulable(kName)
+{
+    SetEnergyBins(fNumberOfBins, 1.e-3*eV, 10.*MeV);   // una banda por década
+    fMessenger = new FluxMessenger(this);
+}
+
+FluxMesh::~FluxMesh()
+{
+    delete fMessenger;
+}
+
+// ------------------------------------------------------------
+// Configuración
+// ------------------------------------------------------------
+G4bool FluxMesh::SetDivisions(G4int nx, G4int ny, G4int nz)
+{
+    if (nx < 1 || ny < 1 || nz < 1) return false;
+    fN[0] = nx;
+    fN[1] = ny;
+    fN[2] = nz;
+    return true;
+}
+
+G4bool FluxMesh::SetEnergyBins(G4int n, G4double eMin, G4double eMax)
+{
+    if (n < 1 || eMin <= 0. || eMax <= eMin) return false;
+    fNumberOfBins = n;
+    fEMin = eMin;
+    fEMax = eMax;
+    fLogEMin = std::log(eMin);
+    fInvLogWidth = n / (std::log(eMax) - fLogEMin);
+    return true;
+}
+
+void FluxMesh::SetExtent(G4double halfX, G4double halfY, G4double halfZ)
+{
+    fHalf[0] = halfX;
+    fHalf[1] = halfY;
+    fHalf[2] = halfZ;
+    for (G4int k = 0; k < 3; ++k) fInvSize[k] = fN[k] / (2.*fHalf[k]);
+
+    // Sin malla activa no se reserva memoria (los hilos y el master
+    // reciben los mismos comandos, así que los tamaños coinciden)
+    std::size_t size = fEnabled ? std::size_t(fNumberOfBins)*VoxelCount() : 0;
+    if (fSum.size() != size) {
+        fSum.assign(size, 0.);
+        fSumSq.assign(size, 0.);
+        fEvent.assign(size, 0.);
+        fTouched.clear();
+        fSum.shrink_to_fit();
+        fSumSq.shrink_to_fit();
+        fEvent.shrink_to_fit();
+    }
+}
+
+// ------------------------------------------------------------
+// Recorrido del segmento por los vóxeles
+// ------------------------------------------------------------
+// Algoritmo de Amanatides y Woo en coordenadas de vóxel: el segmento se
+// recorta a la caja de la malla y se avanza de una pared a la siguiente,
+// sumando a cada vóxel la fracción de longitud que le corresponde.
+void FluxMesh::Score(const G4ThreeVector& a, const G4ThreeVector& b,
+                     G4double kineticEnergy, G4double weight)
+{
+    if (fSum.empty() || kineticEnergy < fEMin || kineticEnergy >= fEMax) return;
+    G4int bin = G4int((std::log(kineticEnergy) - fLogEMin) * fInvLogWidth);
+    bin = std::min(bin, fNumberOfBins - 1);
+
+    G4double length = (b - a).mag();
+    if (length <= 0.) return;
+
+    G4double p[3], d[3];
+    G4double t0 = 0., t1 = 1.;
+    for (G4int k = 0; k < 3; ++k) {
+        p[k] = (a[k] + fHalf[k]) * fInvSize[k];
+        d[k] = (b[k] - a[k]) * fInvSize[k];
+        if (d[k] == 0.) {
+            if (p[k] < 0. || p[k] > fN[k]) return;
+            continue;
+        }
+        G4double tA = -p[k] / d[k];
+        G4double tB = (fN[k] - p[k]) / d[k];
+        if (tA > tB) std::swap(tA, tB);
+        t0 = std::max(t0, tA);
+        t1 = std::min(t1, tB);
+    }
+    if (t0 >= t1) return;
+
+    const G4double inf = std::numeric_limits<G4double>::infinity();
+    G4int index[3], step[3];
+    G4double tMax[3], tDelta[3];
+    for (G4int k = 0; k < 3; ++k) {
+        index[k] = std::clamp(G4int(p[k] + t0*d[k]), 0, fN[k] - 1);
+        step[k] = (d[k] > 0.) ? 1 : -1;
+        if (d[k] != 0.) {
+            tMax[k] = (index[k] + (d[k] > 0. ? 1 : 0) - p[k]) / d[k];
+            tDelta[k] = std::abs(1. / d[k]);
+        } else {
+            tMax[k] = inf;
+            tDelta[k] = inf;
+        }
+    }
+
+    const std::size_t base = std::size_t(bin)*VoxelCount();
+    const G4double score = weight*length;
+    G4double t = t0;
+    while (true) {
+        G4int k = (tMax[0] < tMax[1]) ? (tMax[0] < tMax[2] ? 0 : 2)
+                                      : (tMax[1] < tMax[2] ? 1 : 2);
+        G4double tNext = std::min(tMax[k], t1);
+        if (tNext > t) {
+            Add(base + (std::size_t(index[2])*fN[1] + index[1])*fN[0] + index[0],
+                (tNext - t)*score);
+            t = tNext;
+        }
+        if (t >= t1) break;
+        index[k] += step[k];
+        if (index[k] < 0 || index[k] >= fN[k]) break;
+        tMax[k] += tDelta[k];
+    }
+}
+
+void FluxMesh::EndOfEvent()
+{
+    for (std::size_t i : fTouched) {
+        G4double x = fEvent[i];
+        fSum[i] += x;
+        fSumSq[i] += x*x;
+        fEvent[i] = 0.;
+    }
+    fTouched.clear();
+}
+
+// ------------------------------------------------------------
+// G4VAccumulable
+// ------------------------------------------------------------
+void FluxMesh::Merge(const G4VAccumulable& other)
+{
+    const auto& mesh = static_cast<const FluxMesh&>(other);
+    if (mesh.fSum.size() != fSum.size()) return;
+    for (std::size_t i = 0; i < fSum.size(); ++i) {
+        fSum[i] += mesh.fSum[i];
+        fSumSq[i] += mesh.fSumSq[i];
+    }
+}
+
+void FluxMesh::Reset()
+{
+    std::fill(fSum.begin(), fSum.end(), 0.);
+    std::fill(fSumSq.begin(), fSumSq.end(), 0.);
+    std::fill(fEvent.begin(), fEvent.end(), 0.);
+    fTouched.clear();
+}
+
+// ------------------------------------------------------------
+// Salida binaria
+// ------------------------------------------------------------
+void FluxMesh::Write(const G4String& base, G4int nEvents) const
+{
+    if (fSum.empty() || nEvents <= 0) return;
+
+    // Flujo = longitud de traza / (volumen del vóxel · eventos)
+    G4double volume = (2.*fHalf[0]/fN[0]) * (2.*fHalf[1]/fN[1]) * (2.*fHalf[2]/fN[2]);
+    G4double norm = cm2 / (volume*nEvents);
+    std::vector<float> flux(fSum.size()), error(fSum.size());
+    for (std::size_t i = 0; i < fSum.size(); ++i) {
+        G4double sum = fSum[i];
+        G4double sigma = std::sqrt(std::max(0., fSumSq[i] - sum*sum/nEvents));
+        flux[i] = float(sum*norm);
+        error[i] = (sum > 0.) ? float(sigma/sum) : 0.f;
+    }
+
+    G4bool ok = WriteFloats(base + "_flux.bin", flux) && WriteFloats(base + "_flux_err.bin", error);
+
+    std::ofstream json(base + "_flux.json");
+    char order = ByteOrder();
+    json << "{\n  \"shape\": [" << fNumberOfBins << ", " << fN[2] << ", " << fN[1] << ", " << fN[0] << "],\n"
+         << "  \"axes\": [\"energia\", \"z\", \"y\", \"x\"],\n"
+         << "  \"dtype\": \"" << order << "f4\",\n"
+         << "  \"flux\": \"" << base << "_flux.bin\",\n"
+         << "  \"error\": \"" << base << "_flux_err.bin\",\n"
+         << "  \"units\": \"1/cm2 por neutron fuente\",\n"
+         << "  \"events\": " << nEvents << ",\n"
+         << "  \"half_cm\": [" << fHalf[0]/cm << ", " << fHalf[1]/cm << ", " << fHalf[2]/cm << "],\n"
+         << "  \"energy_edges_eV\": [";
+    for (G4int e = 0; e <= fNumberOfBins; ++e) {
+        json << (e ? ", " : "") << std::exp(fLogEMin + e/fInvLogWidth)/eV;
+    }
+    json << "]\n}\n";
+
+    if (!ok || !json) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir la malla de flujo " << base << "_flux.*";
+        G4Exception("FluxMesh::Write", "Flux001", JustWarning, ed);
+        return;
+    }
+    G4cout << "  Malla de flujo:           " << fNumberOfBins << "x" << fN[2] << "x" << fN[1]
+           << "x" << fN[0] << " en '" << base << "_flux.bin'" << G4endl;
+}
@@ -0,0 +1,92 @@
+#include "FluxMessenger.hh"
+#include "FluxMesh.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor: comandos /flux/
+// ------------------------------------------------------------
+FluxMessenger::FluxMessenger(FluxMesh* mesh)
+ : fMesh(mesh)
+{
+    fFluxDir = new G4UIdirectory("/flux/");
+    fFluxDir->SetGuidance("Flujo de neutrones por longitud de traza en una malla sobre el bloque.");
+
+    fEnableCmd = new G4UIcmdWithABool("/flux/enable", this);
+    fEnableCmd->SetGuidance("Activa la malla de flujo (desactivada por defecto).");
+    fEnableCmd->SetGuidance("Salida: <nombre>_flux.bin, <nombre>_flux_err.bin y <nombre>_flux.json.");
+    fEnableCmd->SetParameterName("enable", true);
+    fEnableCmd->SetDefaultValue(true);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fMeshCmd = new G4UIcommand("/flux/mesh", this);
+    fMeshCmd->SetGuidance("Vóxeles en x, y, z (la malla cubre todo el bloque; por defecto 10 10 20).");
+    for (const char* name : {"nx", "ny", "nz"}) {
+        fMeshCmd->SetParameter(new G4UIparameter(name, 'i', false));
+    }
+    fMeshCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fEnergyCmd = new G4UIcommand("/flux/energyBins", this);
+    fEnergyCmd->SetGuidance("N bandas logarítmicas de energía entre eMin y eMax");
+    fEnergyCmd->SetGuidance("(por defecto 10 bandas de 1 meV a 10 MeV, una por década).");
+    auto nPrm = new G4UIparameter("n", 'i', false);
+    nPrm->SetParameterRange("n > 0");
+    fEnergyCmd->SetParameter(nPrm);
+    fEnergyCmd->SetParameter(new G4UIparameter("eMin", 'd', false));
+    fEnergyCmd->SetParameter(new G4UIparameter("eMax", 'd', false));
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultValue("eV");
+    fEnergyCmd->SetParameter(unitPrm);
+    fEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+FluxMessenger::~FluxMessenger()
+{
+    delete fEnableCmd;
+    delete fMeshCmd;
+    delete fEnergyCmd;
+    delete fFluxDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con FluxMesh
+// ------------------------------------------------------------
+void FluxMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    std::istringstream is(newValue);
+    if (command == fEnableCmd) {
+        fMesh->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fMeshCmd) {
+        G4int nx, ny, nz;
+        is >> nx >> ny >> nz;
+        if (!fMesh->SetDivisions(nx, ny, nz)) {
+            G4ExceptionDescription ed;
+            ed << "Malla de flujo inválida: '" << newValue << "' (se necesitan enteros > 0).";
+            G4Exception("FluxMessenger::SetNewValue", "Flux002", JustWarning, ed);
+        }
+    }
+    else if (command == fEnergyCmd) {
+        G4int n;
+        G4double eMin, eMax;
+        G4String unitName;
+        is >> n >> eMin >> eMax >> unitName;
+        G4double unit = (G4UnitDefinition::GetCategory(unitName) == "Energy")
+                        ? G4UIcommand::ValueOf(unitName) : 0.;
+        if (unit <= 0. || !fMesh->SetEnergyBins(n, eMin*unit, eMax*unit)) {
+            G4ExceptionDescription ed;
+            ed << "Bandas de flujo inválidas: '" << newValue << "' (se necesita 0 < eMin < eMax"
+               << " y una unidad de energía).";
+            G4Exception("FluxMessenger::SetNewValue", "Flux003", JustWarning, ed);
+        }
+    }
+}
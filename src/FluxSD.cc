@@ -0,0 +1,91 @@
+#include "FluxSD.hh"
+#include "FluxMesh.hh"
+#include "ThermalizationTally.hh"
+#include "DepthPlanes.hh"
+#include "CollisionRecorder.hh"
+#include "RunAction.hh"
+
+#include "G4Step.hh"
+#include "G4Neutron.hh"
+#include "G4VProcess.hh"
+#include "G4ProcessType.hh"
+#include "G4AccumulableManager.hh"
+#include "G4HadronicProcess.hh"
+#include "G4RunManager.hh"
+
+FluxSD::FluxSD(const G4String& name)
+ : G4VSensitiveDetector(name),
+   fMesh(nullptr),
+   fThermal(nullptr),
+   fPlanes(nullptr),
+   fCollisions(nullptr),
+   fNeutron(G4Neutron::Definition())
+{}
+
+FluxSD::~FluxSD() = default;
+
+void FluxSD::Initialize(G4HCofThisEvent*)
+{
+    // La RunAction del hilo registra los acumulables antes del primer run
+    if (!fMesh) {
+        auto accumulableManager = G4AccumulableManager::Instance();
+        fMesh = static_cast<FluxMesh*>(accumulableManager->GetAccumulable(FluxMesh::kName));
+        fThermal = static_cast<ThermalizationTally*>(
+            accumulableManager->GetAccumulable(ThermalizationTally::kName));
+        fPlanes = static_cast<DepthPlanes*>(accumulableManager->GetAccumulable(DepthPlanes::kName));
+        auto runAction = static_cast<const RunAction*>(G4RunManager::GetRunManager()->GetUserRunAction());
+        fCollisions = runAction->GetCollisionRecorder();
+    }
+}
+
+G4bool FluxSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
+{
+    auto track = aStep->GetTrack();
+    if (track->GetDefinition() != fNeutron) return false;
+
+    // Estimador de longitud de traza: la energía y el peso del paso son
+    // los del punto previo (las colisiones ocurren al final del paso)
+    G4StepPoint* pre = aStep->GetPreStepPoint();
+    G4StepPoint* post = aStep->GetPostStepPoint();
+    if (fMesh->IsEnabled()) {
+        fMesh->Score(pre->GetPosition(), post->GetPosition(),
+                     pre->GetKineticEnergy(), pre->GetWeight());
+    }
+    if (fPlanes->IsEnabled()) {
+        fPlanes->Score(track, pre->GetPosition(), post->GetPosition(),
+                       pre->GetKineticEnergy(), pre->GetWeight());
+        fPlanes->PassToSecondaries(aStep);
+    }
+
+    if (fCollisions->IsRecording()) fCollisions->SetTrack(track->GetTrackID(), track->GetParentID());
+
+    // Colisión: paso limitado por un proceso hadrónico (no por la
+    // geometría, los límites de paso o la ventana de importancia)
+    auto process = post->GetProcessDefinedStep();
+    if (!process || process->GetProcessType() != fHadronic) return true;
+    // En una captura (o cualquier absorción) el neutrón termina con E = 0:
+    // no cruzó los límites de banda, así que no cuenta para la termalización
+    if (fThermal->IsEnabled() && track->GetTrackStatus() == fAlive &&
+        post->GetKineticEnergy() > 0.) {
+        fThermal->AddCollision(track->GetTrackID(), post->GetKineticEnergy(), post->GetLocalTime(),
+                               pre->GetWeight(), track->GetVertexKineticEnergy());
+    }
+    if (fCollisions->IsRecording()) {
+        // Núcleo blanco de la colisión (los modelos HP lo actualizan con el
+        // isótopo que realmente eligieron); 0 si el proceso no lo expone
+        auto hadronic = dynamic_cast<const G4HadronicProcess*>(process);
+        const G4Nucleus* target = hadronic ? hadronic->GetTargetNucleus() : nullptr;
+        G4int za = target ? 1000*target->GetZ_asInt() + target->GetA_asInt() : 0;
+        fCollisions->AddCollision(pre->GetKineticEnergy(), post->GetKineticEnergy(),
+                                  post->GetGlobalTime(), post->GetPosition(), pre->GetWeight(),
+                                  za, process->GetProcessSubType());
+    }
+    return true;
+}
+
+void FluxSD::EndOfEvent(G4HCofThisEvent*)
+{
+    if (fMesh->IsEnabled()) fMesh->EndOfEvent();
+    fThermal->EndOfEvent();
+    if (fPlanes->IsEnabled()) fPlanes->EndOfEvent();
+}
@@ -0,0 +1,175 @@
+#include "GeometrySweep.hh"
+#include "SweepMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "RunAction.hh"
+#include "Convergence.hh"
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4Timer.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+GeometrySweep::GeometrySweep(DetectorConstruction* detector, Convergence* convergence)
+ : fDetector(detector),
+   fMessenger(nullptr),
+   fConvergence(convergence),
+   fEvents(1000000),
+   fOutputFile("resultados_parafina.csv"),
+   fGunOffset(0.1*cm)
+{
+    for (G4int i = 0; i < 3; ++i) {
+        fMin[i] = fMax[i] = 0.;
+        fStep[i] = 0.;
+    }
+    fMessenger = new SweepMessenger(this);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+GeometrySweep::~GeometrySweep()
+{
+    delete fMessenger;
+}
+
+// ------------------------------------------------------------
+// Configuración
+// ------------------------------------------------------------
+void GeometrySweep::SetRange(G4int axis, G4double min, G4double max, G4double step)
+{
+    fMin[axis] = min;
+    fMax[axis] = max;
+    fStep[axis] = step;
+    fFilePoints.clear();  // un rango explícito reemplaza el archivo
+}
+
+void GeometrySweep::LoadFile(const G4String& fileName)
+{
+    std::ifstream in(fileName);
+    if (!in) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo abrir el archivo de barrido " << fileName;
+        G4Exception("GeometrySweep::LoadFile", "Sweep001", JustWarning, ed);
+        return;
+    }
+
+    fFilePoints.clear();
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        Point p;
+        if (is >> p.x >> p.y >> p.z) {
+            fFilePoints.push_back({p.x*cm, p.y*cm, p.z*cm});
+        }
+    }
+    G4cout << "Barrido: " << fFilePoints.size() << " puntos leídos de " << fileName << G4endl;
+}
+
+std::vector<G4double> GeometrySweep::AxisValues(G4int axis) const
+{
+    std::vector<G4double> values;
+    if (fStep[axis] <= 0.) {
+        // Sin rango: se usa la dimensión actual del bloque
+        if (axis == 0)      values.push_back(fDetector->GetParaffinX());
+        else if (axis == 1) values.push_back(fDetector->GetParaffinY());
+        else                values.push_back(fDetector->GetParaffinZ());
+        return values;
+    }
+
+    // Tolerancia para incluir el extremo superior a pesar del redondeo
+    G4int n = G4int((fMax[axis] - fMin[axis]) / fStep[axis] + 1.e-6) + 1;
+    for (G4int i = 0; i < n; ++i) values.push_back(fMin[axis] + i*fStep[axis]);
+    return values;
+}
+
+std::vector<GeometrySweep::Point> GeometrySweep::BuildGrid() const
+{
+    if (!fFilePoints.empty()) return fFilePoints;
+
+    std::vector<Point> points;
+    for (auto x : AxisValues(0)) {
+        for (auto y : AxisValues(1)) {
+            for (auto z : AxisValues(2)) {
+                points.push_back({x, y, z});
+            }
+        }
+    }
+    return points;
+}
+
+// ------------------------------------------------------------
+// Ejecución del barrido
+// ------------------------------------------------------------
+// La física (QGSP_BERT_HP y los datos HP) se inicializa una sola vez; en
+// cada punto sólo se modifica la geometría en el lugar y se corre beamOn.
+void GeometrySweep::Run()
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto UImanager = G4UImanager::GetUIpointer();
+    auto runAction = static_cast<const RunAction*>(runManager->GetUserRunAction());
+
+    std::vector<Point> points = BuildGrid();
+
+    // Se agrega a la tabla existente; el encabezado sólo si está vacía
+    std::ofstream out(fOutputFile, std::ios::app);
+    if (!out) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo abrir el archivo de resultados " << fOutputFile;
+        G4Exception("GeometrySweep::Run", "Sweep002", JustWarning, ed);
+        return;
+    }
+    if (out.tellp() == 0) {
+        out << "Ancho_(cm),Alto_(cm),Espesor_(cm),Detectados";
+        for (G4int b = 0; b < runAction->GetNumberOfBands(); ++b) {
+            out << "," << runAction->GetBandLabel(b);
+        }
+        out << ",Eventos,Tiempo_s,ErrorRel\n";
+    }
+
+    G4Timer timer;
+    timer.Start();
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const Point& p = points[i];
+        G4cout << "\n🔹 Barrido " << i + 1 << "/" << points.size() << ": bloque "
+               << 2*p.x/cm << "×" << 2*p.y/cm << "×" << 2*p.z/cm << " cm" << G4endl;
+
+        fDetector->SetParaffinX(p.x);
+        fDetector->SetParaffinY(p.y);
+        fDetector->SetParaffinZ(p.z);
+
+        // El cañón se mueve con la cara de entrada del bloque
+        std::ostringstream gun;
+        gun << "/gun/position 0 0 " << -(p.z + fGunOffset)/cm << " cm";
+        UImanager->ApplyCommand(gun.str());
+
+        // Sin /convergence/ un solo lote con todos los eventos
+        RunAction::Tallies tallies;
+        for (G4int n; (n = fConvergence->NextBatch(tallies, fEvents)) > 0; ) {
+            runManager->BeamOn(n);
+            RunAction::Tallies batch = runAction->GetTallies();
+            tallies.Add(batch);
+            if (batch.events < n) break;   // run abortado
+        }
+        fConvergence->Print(tallies);
+
+        out << 2*p.x/cm << "," << 2*p.y/cm << "," << 2*p.z/cm << ","
+            << tallies.detected;
+        for (G4double count : tallies.bands) out << "," << count;
+        out << "," << tallies.events << "," << tallies.time << ","
+            << fConvergence->GetRelativeError(tallies) << "\n";
+        out.flush();
+    }
+
+    timer.Stop();
+
+    G4cout << "\n✅ Barrido completado: " << points.size() << " puntos en "
+           << timer.GetRealElapsed() << " s. Resultados en '" << fOutputFile << "'" << G4endl;
+}
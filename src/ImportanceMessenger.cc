@@ -0,0 +1,81 @@
+#include "ImportanceMessenger.hh"
+#include "ImportanceWorld.hh"
+
+#include "BiasingComparison.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithABool.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /biasing/
+// ------------------------------------------------------------
+ImportanceMessenger::ImportanceMessenger(ImportanceWorld* world)
+ : fWorld(world)
+{
+    // El almacén de importancias es compartido: sólo el master lo modifica
+    fBiasingDir = new G4UIdirectory("/biasing/", false);
+    fBiasingDir->SetGuidance("Muestreo por importancia geométrica en la parafina (opción -b).");
+
+    fCellsCmd = new G4UIcmdWithAnInteger("/biasing/cells", this);
+    fCellsCmd->SetGuidance("Número de capas de importancia a lo largo del espesor del bloque.");
+    fCellsCmd->SetParameterName("cells", false);
+    fCellsCmd->SetRange("cells > 0");
+    fCellsCmd->AvailableForStates(G4State_PreInit);
+    fCellsCmd->SetToBeBroadcasted(false);
+
+    fRatioCmd = new G4UIcmdWithADouble("/biasing/ratio", this);
+    fRatioCmd->SetGuidance("Factor de importancia entre capas consecutivas (splitting por capa).");
+    fRatioCmd->SetParameterName("ratio", false);
+    fRatioCmd->SetRange("ratio >= 1.");
+    fRatioCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fRatioCmd->SetToBeBroadcasted(false);
+
+    fEnableCmd = new G4UIcmdWithABool("/biasing/enable", this);
+    fEnableCmd->SetGuidance("false: todas las importancias a 1 (run análogo, sin splitting).");
+    fEnableCmd->SetParameterName("enable", true);
+    fEnableCmd->SetDefaultValue(true);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEnableCmd->SetToBeBroadcasted(false);
+
+    fCompareCmd = new G4UIcmdWithAnInteger("/biasing/compare", this);
+    fCompareCmd->SetGuidance("Corre N eventos análogos y N con muestreo y compara la figura de mérito");
+    fCompareCmd->SetGuidance("de la fracción transmitida en la primera banda (térmicos).");
+    fCompareCmd->SetParameterName("events", false);
+    fCompareCmd->SetRange("events > 0");
+    fCompareCmd->AvailableForStates(G4State_Idle);
+    fCompareCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+ImportanceMessenger::~ImportanceMessenger()
+{
+    delete fCellsCmd;
+    delete fRatioCmd;
+    delete fEnableCmd;
+    delete fCompareCmd;
+    delete fBiasingDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con ImportanceWorld
+// ------------------------------------------------------------
+void ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fCellsCmd) {
+        fWorld->SetNumberOfCells(fCellsCmd->GetNewIntValue(newValue));
+    }
+    else if (command == fRatioCmd) {
+        fWorld->SetRatio(fRatioCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fEnableCmd) {
+        fWorld->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fCompareCmd) {
+        BiasingComparison comparison(fWorld);
+        comparison.Run(fCompareCmd->GetNewIntValue(newValue));
+    }
+}
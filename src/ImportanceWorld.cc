@@ -0,0 +1,149 @@
+#include "ImportanceWorld.hh"
+#include "ImportanceMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4IStore.hh"
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+ImportanceWorld::ImportanceWorld(DetectorConstruction* detector)
+ : G4VUserParallelWorld("ImportanceWorld"),
+   fDetector(detector),
+   fNumCells(10),
+   fRatio(2.),
+   fEnabled(true),
+   fGhostWorld(nullptr)
+{
+    fMessenger = new ImportanceMessenger(this);
+
+    // Sólo se muestrean neutrones. El volumen del mundo se toma de G4IStore
+    // cuando G4ImportanceBiasing construye los procesos.
+    fSampler = new G4GeometrySampler(nullptr, "neutron");
+    fSampler->SetParallel(true);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+ImportanceWorld::~ImportanceWorld()
+{
+    delete fSampler;
+    delete fMessenger;
+}
+
+void ImportanceWorld::RegisterPhysics(G4VModularPhysicsList* physicsList)
+{
+    physicsList->RegisterPhysics(new G4ImportanceBiasing(fSampler, GetName()));
+    physicsList->RegisterPhysics(new G4ParallelWorldPhysics(GetName()));
+}
+
+// ------------------------------------------------------------
+// Construcción de las celdas (sólo en el master)
+// ------------------------------------------------------------
+// Se llama también después de una reconstrucción completa de la geometría
+// (/detector/stepLimit/ con cambios de estructura): el almacén de
+// importancias se vacía y se llena con los volúmenes nuevos.
+void ImportanceWorld::Construct()
+{
+    fGhostWorld = GetWorld();
+    G4LogicalVolume* ghostLogical = fGhostWorld->GetLogicalVolume();
+    auto worldBox = static_cast<G4Box*>(ghostLogical->GetSolid());
+
+    // Capas del bloque (0 .. N-1) y región de salida (N). El tamaño y la
+    // posición en z los fija PlaceCells().
+    fCellSolids.clear();
+    fCells.clear();
+    for (G4int i = 0; i <= fNumCells; ++i) {
+        auto solid = new G4Box("ImportanceCell", worldBox->GetXHalfLength(),
+                               worldBox->GetYHalfLength(), 1*mm);
+        auto logic = new G4LogicalVolume(solid, nullptr, "ImportanceCell");
+        fCells.push_back(new G4PVPlacement(0, G4ThreeVector(), logic, "ImportanceCell",
+                                           ghostLogical, false, i));
+        fCellSolids.push_back(solid);
+    }
+    PlaceCells();
+
+    // Almacén de importancias (compartido por todos los hilos). Delante del
+    // bloque, el propio mundo paralelo, la importancia es 1.
+    G4IStore* store = G4IStore::GetInstance(GetName());
+    store->Clear();
+    store->SetParallelWorldVolume(GetName());
+    store->AddImportanceGeometryCell(1., *fGhostWorld);
+    for (G4int i = 0; i <= fNumCells; ++i) {
+        store->AddImportanceGeometryCell(GetImportance(i), *fCells[i], i);
+    }
+}
+
+// Capas de igual espesor sobre el bloque y la región de salida hasta el
+// borde del mundo
+void ImportanceWorld::PlaceCells()
+{
+    G4double blockHalfZ = fDetector->GetParaffinZ();
+    G4double worldHalfZ = static_cast<G4Box*>(fGhostWorld->GetLogicalVolume()->GetSolid())->GetZHalfLength();
+
+    G4double cellHalfZ = blockHalfZ / fNumCells;
+    for (G4int i = 0; i < fNumCells; ++i) {
+        fCellSolids[i]->SetZHalfLength(cellHalfZ);
+        fCells[i]->SetTranslation(G4ThreeVector(0, 0, -blockHalfZ + (2*i + 1)*cellHalfZ));
+    }
+
+    G4double exitHalfZ = 0.5*(worldHalfZ - blockHalfZ);
+    fCellSolids[fNumCells]->SetZHalfLength(exitHalfZ);
+    fCells[fNumCells]->SetTranslation(G4ThreeVector(0, 0, blockHalfZ + exitHalfZ));
+}
+
+// ------------------------------------------------------------
+// Cambios entre runs
+// ------------------------------------------------------------
+// El espesor cambia en el lugar: los volúmenes (y las claves del almacén de
+// importancias) siguen siendo los mismos
+void ImportanceWorld::UpdateGeometry()
+{
+    if (!fCells.empty()) PlaceCells();
+}
+
+void ImportanceWorld::ResetCells()
+{
+    fGhostWorld = nullptr;
+    fCellSolids.clear();
+    fCells.clear();
+}
+
+void ImportanceWorld::SetRatio(G4double ratio)
+{
+    fRatio = ratio;
+    ApplyImportances();
+}
+
+void ImportanceWorld::SetEnabled(G4bool value)
+{
+    fEnabled = value;
+    ApplyImportances();
+}
+
+void ImportanceWorld::ApplyImportances()
+{
+    if (fCells.empty()) return;  // se aplican en Construct()
+    G4IStore* store = G4IStore::GetInstance(GetName());
+    for (G4int i = 0; i <= fNumCells; ++i) {
+        store->ChangeImportance(GetImportance(i), *fCells[i], i);
+    }
+}
+
+G4double ImportanceWorld::GetImportance(G4int cell) const
+{
+    if (!fEnabled) return 1.;
+    return std::pow(fRatio, std::min(cell, fNumCells - 1));
+}
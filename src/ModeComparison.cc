@@ -0,0 +1,92 @@
+#include "ModeComparison.hh"
+#include "RunAction.hh"
+
+#include "G4RunManager.hh"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+ModeComparison::ModeComparison(const G4String& offName, const G4String& offTitle,
+                               const G4String& onName, const G4String& onTitle, Toggle toggle)
+ : fName{offName, onName},
+   fTitle{offTitle, onTitle},
+   fToggle(std::move(toggle))
+{}
+
+void ModeComparison::AddColumn(const G4String& header, const G4String& label, Counter counter)
+{
+    fColumns.push_back({header, label, std::move(counter)});
+}
+
+// ------------------------------------------------------------
+// Ejecución: modo apagado y encendido
+// ------------------------------------------------------------
+void ModeComparison::Run(G4int nEvents, const G4String& outputFile)
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto runAction = static_cast<const RunAction*>(runManager->GetUserRunAction());
+
+    for (G4int m = 0; m < 2; ++m) {
+        G4cout << "\n🔹 Run " << fTitle[m] << ", " << nEvents << " eventos" << G4endl;
+        fToggle(m == 1);
+        runManager->BeamOn(nEvents);
+
+        Result& r = fResults[m];
+        r = Result();
+        r.time = runAction->GetRunTime();
+        for (const auto& column : fColumns) r.values.push_back(column.counter(*runAction));
+        for (G4int b = 0; b < runAction->GetNumberOfBands(); ++b) {
+            r.counts.push_back(runAction->GetBandCount(b));
+            r.errors.push_back(runAction->GetBandError(b));
+        }
+    }
+
+    // --- Reporte ---
+    std::ofstream out(outputFile);
+    out << "Modo,Eventos,Tiempo_s,EventosPorSegundo";
+    for (const auto& column : fColumns) out << "," << column.header;
+    for (G4int b = 0; b < runAction->GetNumberOfBands(); ++b) out << "," << runAction->GetBandLabel(b);
+    out << "\n";
+
+    G4cout << "\n Modo      Tiempo (s)    Eventos/s";
+    for (const auto& column : fColumns) G4cout << std::setw(13) << column.label;
+    G4cout << G4endl;
+    for (G4int m = 0; m < 2; ++m) {
+        const Result& r = fResults[m];
+        G4double rate = (r.time > 0.) ? nEvents / r.time : 0.;
+        G4cout << " " << std::setw(9) << std::left << fName[m] << std::right
+               << std::setw(11) << r.time << std::setw(13) << rate;
+        for (G4double value : r.values) G4cout << std::setw(13) << value;
+        G4cout << G4endl;
+
+        out << fName[m] << "," << nEvents << "," << r.time << "," << rate;
+        for (G4double value : r.values) out << "," << value;
+        for (G4double count : r.counts) out << "," << count;
+        out << "\n";
+    }
+
+    const Result& off = fResults[0];
+    const Result& on = fResults[1];
+    G4cout << " Aceleración (" << fName[0] << "/" << fName[1] << "): "
+           << (on.time > 0. ? off.time / on.time : 0.) << G4endl;
+
+    // Un modo que no sesga deja los conteos dentro de la estadística
+    for (std::size_t b = 0; b < off.counts.size(); ++b) {
+        G4double sigma = std::sqrt(off.errors[b]*off.errors[b] + on.errors[b]*on.errors[b]);
+        G4double z = (sigma > 0.) ? (on.counts[b] - off.counts[b]) / sigma : 0.;
+        G4cout << "   " << std::setw(18) << std::left << runAction->GetBandLabel(b) << std::right
+               << std::setw(10) << off.counts[b] << std::setw(10) << on.counts[b]
+               << "   " << z << " sigma" << (std::abs(z) < 3. ? "" : "  ⚠️") << G4endl;
+    }
+    if (!out) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir " << outputFile;
+        G4Exception("ModeComparison::Run", "Compare001", JustWarning, ed);
+        return;
+    }
+    G4cout << "✅ Comparación guardada en '" << outputFile << "'" << G4endl;
+}
@@ -0,0 +1,60 @@
+#include "NeutronHPPhysics.hh"
+
+#include "G4Neutron.hh"
+#include "G4ProcessManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include "G4HadronElasticProcess.hh"
+#include "G4ParticleHPElastic.hh"
+#include "G4ParticleHPElasticData.hh"
+#include "G4ParticleHPThermalScattering.hh"
+#include "G4ParticleHPThermalScatteringData.hh"
+
+#include "G4HadronInelasticProcess.hh"
+#include "G4ParticleHPInelastic.hh"
+#include "G4ParticleHPInelasticData.hh"
+
+#include "G4NeutronCaptureProcess.hh"
+#include "G4ParticleHPCapture.hh"
+#include "G4ParticleHPCaptureData.hh"
+
+NeutronHPPhysics::NeutronHPPhysics(G4bool thermalScattering)
+ : G4VPhysicsConstructor("NeutronHP"),
+   fThermalScattering(thermalScattering)
+{}
+
+void NeutronHPPhysics::ConstructParticle()
+{
+    G4Neutron::Definition();
+}
+
+void NeutronHPPhysics::ConstructProcess()
+{
+    G4ProcessManager* manager = G4Neutron::Definition()->GetProcessManager();
+
+    // --- Elástica: HP, y S(α,β) por debajo de 4 eV si se pide ---
+    auto elastic = new G4HadronElasticProcess();
+    auto elasticModel = new G4ParticleHPElastic();
+    elastic->AddDataSet(new G4ParticleHPElasticData());
+    elastic->RegisterMe(elasticModel);
+    if (fThermalScattering) {
+        elasticModel->SetMinEnergy(4.*eV);
+        auto thermalModel = new G4ParticleHPThermalScattering();
+        thermalModel->SetMaxEnergy(4.*eV);
+        elastic->RegisterMe(thermalModel);
+        elastic->AddDataSet(new G4ParticleHPThermalScatteringData());
+    }
+    manager->AddDiscreteProcess(elastic);
+
+    // --- Inelástica (n,n'), (n,p), (n,α)... ---
+    auto inelastic = new G4HadronInelasticProcess("neutronInelastic", G4Neutron::Definition());
+    inelastic->AddDataSet(new G4ParticleHPInelasticData());
+    inelastic->RegisterMe(new G4ParticleHPInelastic());
+    manager->AddDiscreteProcess(inelastic);
+
+    // --- Captura radiativa ---
+    auto capture = new G4NeutronCaptureProcess();
+    capture->AddDataSet(new G4ParticleHPCaptureData());
+    capture->RegisterMe(new G4ParticleHPCapture());
+    manager->AddDiscreteProcess(capture);
+}
@@ -0,0 +1,34 @@
+#include "NeutronPhysicsList.hh"
+#include "NeutronHPPhysics.hh"
+
+#include "G4EmStandardPhysics.hh"
+#include "G4BosonConstructor.hh"
+#include "G4LeptonConstructor.hh"
+#include "G4MesonConstructor.hh"
+#include "G4BaryonConstructor.hh"
+#include "G4IonConstructor.hh"
+
+NeutronPhysicsList::NeutronPhysicsList(G4bool thermalScattering)
+ : G4VModularPhysicsList()
+{
+    SetVerboseLevel(0);
+    RegisterPhysics(new G4EmStandardPhysics(0));
+    RegisterPhysics(new NeutronHPPhysics(thermalScattering));
+}
+
+// Los productos de las reacciones HP (protones, alfas, núcleos de
+// retroceso, gammas) necesitan sus definiciones aunque no haya física
+// hadrónica para ellos
+void NeutronPhysicsList::ConstructParticle()
+{
+    G4BosonConstructor bosons;
+    bosons.ConstructParticle();
+    G4LeptonConstructor leptons;
+    leptons.ConstructParticle();
+    G4MesonConstructor mesons;
+    mesons.ConstructParticle();
+    G4BaryonConstructor baryons;
+    baryons.ConstructParticle();
+    G4IonConstructor ions;
+    ions.ConstructParticle();
+}
@@ -0,0 +1,112 @@
+#include "PhysicsTableCache.hh"
+
+#include "G4VUserPhysicsList.hh"
+#include "G4StateManager.hh"
+#include "G4Material.hh"
+#include "G4Element.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Version.hh"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+PhysicsTableCache::PhysicsTableCache(G4VUserPhysicsList* physicsList,
+                                     const G4String& physicsName,
+                                     const G4String& baseDirectory)
+ : G4VStateDependent(),
+   fPhysicsList(physicsList),
+   fPhysicsName(physicsName),
+   fBaseDirectory(baseDirectory),
+   fInitPhases(0),
+   fStore(false)
+{}
+
+// ------------------------------------------------------------
+// Clave: versión de Geant4, lista de física, materiales y cortes
+// ------------------------------------------------------------
+G4String PhysicsTableCache::BuildKey() const
+{
+    std::ostringstream key;
+    key << std::setprecision(10);
+    key << "geant4 " << G4Version << "\n";
+    key << "physics " << fPhysicsName << "\n";
+    key << "defaultCut " << fPhysicsList->GetDefaultCutValue() << "\n";
+
+    for (const auto material : *G4Material::GetMaterialTable()) {
+        key << "material " << material->GetName() << " " << material->GetDensity();
+        const G4double* fractions = material->GetFractionVector();
+        for (std::size_t i = 0; i < material->GetNumberOfElements(); ++i) {
+            key << " " << material->GetElement(i)->GetName() << ":" << fractions[i];
+        }
+        key << "\n";
+    }
+
+    const char* particles[4] = {"gamma", "e-", "e+", "proton"};
+    for (const auto region : *G4RegionStore::GetInstance()) {
+        auto cuts = region->GetProductionCuts();
+        if (!cuts) continue;
+        key << "region " << region->GetName();
+        for (auto particle : particles) key << " " << cuts->GetProductionCut(particle);
+        key << "\n";
+    }
+    return key.str();
+}
+
+// ------------------------------------------------------------
+// Transiciones de estado
+// ------------------------------------------------------------
+G4bool PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+    G4ApplicationState current = G4StateManager::GetStateManager()->GetCurrentState();
+    if (current != G4State_Init || requestedState != G4State_Idle) return true;
+
+    if (fInitPhases == 0) {
+        // Fin de /run/initialize: geometría, materiales y cortes ya existen
+        fKey = BuildKey();
+        std::ostringstream dir;
+        dir << fBaseDirectory << "/" << fPhysicsName << "_" << std::hex
+            << std::hash<std::string>{}(fKey);
+        fDirectory = dir.str();
+
+        if (std::filesystem::exists(fDirectory + "/key.txt")) {
+            G4cout << "Caché de física: recuperando tablas de " << fDirectory << G4endl;
+            fPhysicsList->SetPhysicsTableRetrieved(fDirectory);
+        } else {
+            fStore = true;
+        }
+    }
+    else if (fInitPhases == 1 && fStore) {
+        // Fin de la primera construcción de tablas. Varios procesos pueden
+        // llenar la caché a la vez (shards): cada uno escribe en un
+        // directorio temporal propio y lo renombra; si otro llegó antes, se
+        // descarta el temporal.
+        std::ostringstream tmp;
+        tmp << fDirectory << ".tmp" << std::hex << std::random_device{}();
+        G4String tmpDirectory = tmp.str();
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::string(tmpDirectory), ec);
+        if (!ec && fPhysicsList->StorePhysicsTable(tmpDirectory)) {
+            std::ofstream(tmpDirectory + "/key.txt") << fKey;
+            std::filesystem::rename(std::string(tmpDirectory), std::string(fDirectory), ec);
+            if (ec) std::filesystem::remove_all(std::string(tmpDirectory), ec);
+            G4cout << "Caché de física: tablas guardadas en " << fDirectory << G4endl;
+        } else {
+            std::filesystem::remove_all(std::string(tmpDirectory), ec);
+            G4cout << "Caché de física: no se pudieron guardar las tablas en "
+                   << fDirectory << G4endl;
+        }
+        fStore = false;
+    }
+    ++fInitPhases;
+    return true;
+}
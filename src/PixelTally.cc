@@ -0,0 +1,135 @@
+#include "PixelTally.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+
+const G4String PixelTally::kName = "PixelTally";
+
+namespace {
+
+char ByteOrder()
+{
+    const std::uint16_t one = 1;
+    return (*reinterpret_cast<const char*>(&one) == 1) ? '<' : '>';
+}
+
+G4bool WriteFloats(const G4String& fileName, const std::vector<float>& values)
+{
+    std::ofstream out(fileName, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(float));
+    return bool(out);
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+PixelTally::PixelTally()
+ : G4VAccumulable(kName)
+{}
+
+void PixelTally::SetShape(G4int nx, G4int ny, G4int nBands)
+{
+    fN[0] = std::max(nx, 0);
+    fN[1] = std::max(ny, 0);
+    fNumberOfBands = nBands;
+
+    // Los hilos y el master reciben los mismos comandos: los tamaños coinciden
+    std::size_t size = std::size_t(fN[0])*fN[1]*fNumberOfBands;
+    if (fSum.size() != size) {
+        fSum.assign(size, 0.);
+        fSumSq.assign(size, 0.);
+        fEvent.assign(size, 0.);
+        fTouched.clear();
+        fSum.shrink_to_fit();
+        fSumSq.shrink_to_fit();
+        fEvent.shrink_to_fit();
+    }
+}
+
+// ------------------------------------------------------------
+// Llenado
+// ------------------------------------------------------------
+void PixelTally::EndOfEvent()
+{
+    for (std::size_t i : fTouched) {
+        G4double x = fEvent[i];
+        fSum[i] += x;
+        fSumSq[i] += x*x;
+        fEvent[i] = 0.;
+    }
+    fTouched.clear();
+}
+
+// ------------------------------------------------------------
+// G4VAccumulable
+// ------------------------------------------------------------
+void PixelTally::Merge(const G4VAccumulable& other)
+{
+    const auto& tally = static_cast<const PixelTally&>(other);
+    if (tally.fSum.size() != fSum.size()) return;
+    for (std::size_t i = 0; i < fSum.size(); ++i) {
+        fSum[i] += tally.fSum[i];
+        fSumSq[i] += tally.fSumSq[i];
+    }
+}
+
+void PixelTally::Reset()
+{
+    std::fill(fSum.begin(), fSum.end(), 0.);
+    std::fill(fSumSq.begin(), fSumSq.end(), 0.);
+    std::fill(fEvent.begin(), fEvent.end(), 0.);
+    fTouched.clear();
+}
+
+// ------------------------------------------------------------
+// Salida binaria
+// ------------------------------------------------------------
+void PixelTally::Write(const G4String& base, G4int nEvents, const std::vector<G4double>& edges,
+                       G4double pitch) const
+{
+    if (fSum.empty() || nEvents <= 0) return;
+
+    // De [píxel][banda] (orden de llenado) a [banda][iy][ix] (imágenes)
+    std::size_t pixels = std::size_t(fN[0])*fN[1];
+    std::vector<float> counts(fSum.size()), error(fSum.size());
+    for (std::size_t p = 0; p < pixels; ++p) {
+        for (G4int b = 0; b < fNumberOfBands; ++b) {
+            std::size_t i = p*fNumberOfBands + b;
+            std::size_t o = std::size_t(b)*pixels + p;
+            G4double sum = fSum[i];
+            G4double sigma = std::sqrt(std::max(0., fSumSq[i] - sum*sum/nEvents));
+            counts[o] = float(sum/nEvents);
+            error[o] = (sum > 0.) ? float(sigma/sum) : 0.f;
+        }
+    }
+
+    G4bool ok = WriteFloats(base + "_pixels.bin", counts) && WriteFloats(base + "_pixels_err.bin", error);
+
+    std::ofstream json(base + "_pixels.json");
+    json << "{\n  \"shape\": [" << fNumberOfBands << ", " << fN[1] << ", " << fN[0] << "],\n"
+         << "  \"axes\": [\"banda\", \"y\", \"x\"],\n"
+         << "  \"dtype\": \"" << ByteOrder() << "f4\",\n"
+         << "  \"counts\": \"" << base << "_pixels.bin\",\n"
+         << "  \"error\": \"" << base << "_pixels_err.bin\",\n"
+         << "  \"units\": \"neutrones por neutron fuente\",\n"
+         << "  \"events\": " << nEvents << ",\n"
+         << "  \"pitch_cm\": " << pitch/cm << ",\n"
+         << "  \"band_edges_eV\": [";
+    for (std::size_t k = 0; k < edges.size(); ++k) json << (k ? ", " : "") << edges[k]/eV;
+    json << "]\n}\n";
+
+    if (!ok || !json) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir la imagen de píxeles " << base << "_pixels.*";
+        G4Exception("PixelTally::Write", "Pixel001", JustWarning, ed);
+        return;
+    }
+    G4cout << "  Imagen de píxeles:        " << fNumberOfBands << "x" << fN[1] << "x" << fN[0]
+           << " en '" << base << "_pixels.bin'" << G4endl;
+}
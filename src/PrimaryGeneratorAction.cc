@@ -1,9 +1,20 @@
 #include "PrimaryGeneratorAction.hh"
+#include "SourceMessenger.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
 
-PrimaryGeneratorAction::PrimaryGeneratorAction() {
+#include <algorithm>
+#include <cmath>
+
+PrimaryGeneratorAction::PrimaryGeneratorAction()
+ : fDisk(false),
+   fRadius(0.),
+   fCosCone(1.)
+{
     G4int n_particle = 1;
     fParticleGun = new G4ParticleGun(n_particle);
 
@@ -14,12 +25,104 @@ PrimaryGeneratorAction::PrimaryGeneratorAction() {
     fParticleGun->SetParticleEnergy(4200000*eV);
     fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
     fParticleGun->SetParticlePosition(G4ThreeVector(0.,0.,-3.*cm));
+
+    fMessenger = new SourceMessenger(this);
 }
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction() {
+    delete fMessenger;
     delete fParticleGun;
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
+    // Primer uso del motor aleatorio en el evento: con /seed/perEvent todo
+    // lo que sigue depende sólo de (semilla, run, evento)
+    fSeeder.Seed(event);
+
+    // Fuente de /gun/ sin cambios: el camino de siempre
+    if (fEnergySpectrum.IsEmpty() && fAngularSpectrum.IsEmpty() && !fDisk && fCosCone >= 1.) {
+        fParticleGun->GeneratePrimaryVertex(event);
+        return;
+    }
+
+    // Centro, eje y energía de /gun/: se restauran después del vértice
+    const G4ThreeVector center = fParticleGun->GetParticlePosition();
+    const G4ThreeVector axis = fParticleGun->GetParticleMomentumDirection();
+    const G4double energy = fParticleGun->GetParticleEnergy();
+
+    if (!fEnergySpectrum.IsEmpty()) {
+        fParticleGun->SetParticleEnergy(fEnergySpectrum.Sample(G4UniformRand(), G4UniformRand()));
+    }
+
+    if (fDisk && fRadius > 0.) {
+        G4double r = fRadius*std::sqrt(G4UniformRand());
+        G4double phi = twopi*G4UniformRand();
+        G4ThreeVector offset(r*std::cos(phi), r*std::sin(phi), 0.);
+        offset.rotateUz(axis);
+        fParticleGun->SetParticlePosition(center + offset);
+    }
+
+    if (!fAngularSpectrum.IsEmpty() || fCosCone < 1.) {
+        G4double cosTheta = fAngularSpectrum.IsEmpty()
+            ? 1. - G4UniformRand()*(1. - fCosCone)
+            : fAngularSpectrum.Sample(G4UniformRand(), G4UniformRand());
+        G4double sinTheta = std::sqrt(std::max(0., 1. - cosTheta*cosTheta));
+        G4double phi = twopi*G4UniformRand();
+        G4ThreeVector direction(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+        direction.rotateUz(axis);
+        fParticleGun->SetParticleMomentumDirection(direction);
+    }
+
     fParticleGun->GeneratePrimaryVertex(event);
+
+    fParticleGun->SetParticlePosition(center);
+    fParticleGun->SetParticleMomentumDirection(axis);
+    fParticleGun->SetParticleEnergy(energy);
+}
+
+// ------------------------------------------------------------
+// Configuración de la fuente (en cada hilo)
+// ------------------------------------------------------------
+void PrimaryGeneratorAction::LoadEnergySpectrum(const G4String& fileName, G4double unit, G4bool linear) {
+    auto interpolation = linear ? TabulatedSpectrum::kLinear : TabulatedSpectrum::kHistogram;
+    if (!fEnergySpectrum.Load(fileName, unit, interpolation)) {
+        // Igual que la distribución angular: no queda activo un espectro
+        // anterior, la energía vuelve a ser la de /gun/energy
+        fEnergySpectrum.Clear();
+        G4ExceptionDescription ed;
+        ed << "No se pudo leer el espectro " << fileName
+           << " (dos columnas \"E peso\", E creciente, pesos >= 0); se usa /gun/energy";
+        G4Exception("PrimaryGeneratorAction::LoadEnergySpectrum", "Source001", JustWarning, ed);
+        return;
+    }
+    // Todos los hilos cargan el mismo archivo: se informa una sola vez
+    if (G4Threading::G4GetThreadId() <= 0) {
+        G4cout << "Fuente: espectro " << fileName << " de " << G4BestUnit(fEnergySpectrum.GetMin(), "Energy")
+               << " a " << G4BestUnit(fEnergySpectrum.GetMax(), "Energy") << ", media "
+               << G4BestUnit(fEnergySpectrum.GetMean(), "Energy") << G4endl;
+    }
+}
+
+void PrimaryGeneratorAction::LoadAngularSpectrum(const G4String& fileName, G4bool linear) {
+    auto interpolation = linear ? TabulatedSpectrum::kLinear : TabulatedSpectrum::kHistogram;
+    if (!fAngularSpectrum.Load(fileName, 1., interpolation) ||
+        fAngularSpectrum.GetMin() < -1. || fAngularSpectrum.GetMax() > 1.) {
+        fAngularSpectrum.Clear();
+        G4ExceptionDescription ed;
+        ed << "No se pudo leer la distribución angular " << fileName
+           << " (dos columnas \"cosθ peso\", cosθ creciente en [-1, 1])";
+        G4Exception("PrimaryGeneratorAction::LoadAngularSpectrum", "Source002", JustWarning, ed);
+    }
+}
+
+void PrimaryGeneratorAction::SetConeAngle(G4double value) {
+    fCosCone = (value >= pi) ? -1. : std::cos(value);
+}
+
+void PrimaryGeneratorAction::Reset() {
+    fEnergySpectrum.Clear();
+    fAngularSpectrum.Clear();
+    fDisk = false;
+    fRadius = 0.;
+    fCosCone = 1.;
 }
@@ -0,0 +1,107 @@
+#include "ProfileRun.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+// ------------------------------------------------------------
+// Fusión (en el master, con el mutex de Geant4)
+// ------------------------------------------------------------
+void ProfileRun::Merge(const G4Run* run)
+{
+    auto local = static_cast<const ProfileRun*>(run);
+    for (const auto& entry : local->fCounters) fMerged[Names(entry.first)] += entry.second;
+    for (const auto& entry : local->fMerged) fMerged[entry.first] += entry.second;
+
+    G4Run::Merge(run);
+}
+
+ProfileRun::NameKey ProfileRun::Names(const PointerKey& key)
+{
+    return NameKey(key.volume ? key.volume->GetName() : G4String("<fuera>"),
+                   key.particle ? key.particle->GetParticleName() : G4String("<ninguna>"),
+                   key.process ? key.process->GetProcessName() : G4String("primario"));
+}
+
+ProfileRun::Table ProfileRun::GetTable() const
+{
+    Table table = fMerged;
+    for (const auto& entry : fCounters) table[Names(entry.first)] += entry.second;
+    return table;
+}
+
+// ------------------------------------------------------------
+// Reporte
+// ------------------------------------------------------------
+void ProfileRun::Print(G4int maxRows) const
+{
+    Table table = GetTable();
+
+    Counters total;
+    for (const auto& entry : table) total += entry.second;
+
+    G4cout << "\n Perfil de pasos: " << total.steps << " pasos, " << total.tracks
+           << " trazas, " << total.time << " s (suma de los hilos)" << G4endl;
+    PrintProjection(table, 0, maxRows);
+    PrintProjection(table, 1, maxRows);
+    PrintProjection(table, 2, maxRows);
+}
+
+void ProfileRun::PrintProjection(const Table& table, G4int column, G4int maxRows) const
+{
+    std::map<G4String, Counters> projection;
+    Counters total;
+    for (const auto& entry : table) {
+        const G4String& name = (column == 0) ? std::get<0>(entry.first) :
+                               (column == 1) ? std::get<1>(entry.first) : std::get<2>(entry.first);
+        projection[name] += entry.second;
+        total += entry.second;
+    }
+
+    std::vector<std::pair<G4String, Counters>> ranked(projection.begin(), projection.end());
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        return a.second.time > b.second.time;
+    });
+
+    const char* title[3] = {"Volumen", "Partícula", "Proceso"};
+    G4cout << "\n " << std::setw(20) << std::left << title[column] << std::right
+           << "       Pasos      Trazas    Tiempo (s)   % tiempo   µs/paso" << G4endl;
+    G4int rows = 0;
+    for (const auto& entry : ranked) {
+        if (rows++ == maxRows) {
+            G4cout << "   (" << ranked.size() - maxRows << " más en el CSV)" << G4endl;
+            break;
+        }
+        const Counters& c = entry.second;
+        G4double fraction = (total.time > 0.) ? 100.*c.time/total.time : 0.;
+        G4double perStep = (c.steps > 0.) ? 1.e6*c.time/c.steps : 0.;
+        G4cout << " " << std::setw(20) << std::left << entry.first << std::right
+               << std::setw(12) << c.steps << std::setw(12) << c.tracks
+               << std::setw(14) << c.time << std::setw(11) << std::setprecision(3) << fraction
+               << std::setw(10) << perStep << std::setprecision(6) << G4endl;
+    }
+}
+
+void ProfileRun::Write(const G4String& fileName) const
+{
+    std::ofstream out(fileName);
+    if (!out) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir el perfil " << fileName;
+        G4Exception("ProfileRun::Write", "Profile001", JustWarning, ed);
+        return;
+    }
+
+    out << "Volumen,Particula,Proceso,Pasos,Trazas,Tiempo_s\n";
+    for (const auto& entry : GetTable()) {
+        const Counters& c = entry.second;
+        out << std::get<0>(entry.first) << "," << std::get<1>(entry.first) << ","
+            << std::get<2>(entry.first) << "," << c.steps << "," << c.tracks << ","
+            << c.time << "\n";
+    }
+}
@@ -1,19 +1,91 @@
 #include "RunAction.hh"
+#include "RunMessenger.hh"
+#include "ColumnarWriter.hh"
+#include "CollisionRecorder.hh"
+#include "ProfileRun.hh"
+#include "DetectorConstruction.hh"
+#include "TerminationCuts.hh"
 #include "G4Run.hh"
-#include "G4RunManager.hh" // Necesario para obtener el EventID
+#include "G4RunManager.hh"
 #include "G4AnalysisManager.hh"
+#include "G4AccumulableManager.hh"
 #include "G4SystemOfUnits.hh"
 
-RunAction::RunAction() : G4UserRunAction() {}
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
-RunAction::~RunAction() {}
+namespace {
 
-void RunAction::BeginOfRunAction(const G4Run*)
+G4double SumError(G4double sum, G4double sum2, G4int n)
 {
-  auto analysisManager = G4AnalysisManager::Instance();
+  return (n > 0) ? std::sqrt(std::max(0., sum2 - sum*sum/n)) : 0.;
+}
+
+}
+
+RunAction::RunAction()
+ : G4UserRunAction(),
+   fBandEdges{0.025*eV, 0.5*eV},   // térmicos / epitérmicos / rápidos
+   fDetected("Detected", 0.),
+   fDetectedSq("DetectedSq", 0.),
+   fDropped("StackDropped", 0.)
+{
+  fMessenger = new RunMessenger(this);
+
+  // Conteos por banda: cada hilo acumula los suyos y se suman en el master
+  auto accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(fDetected);
+  accumulableManager->RegisterAccumulable(fDetectedSq);
+  fBands.reserve(kMaxBands);
+  fBandsSq.reserve(kMaxBands);
+  for (G4int i = 0; i < kMaxBands; ++i) {
+    fBands.emplace_back("Band" + std::to_string(i), 0.);
+    fBandsSq.emplace_back("BandSq" + std::to_string(i), 0.);
+    accumulableManager->RegisterAccumulable(fBands.back());
+    accumulableManager->RegisterAccumulable(fBandsSq.back());
+  }
+
+  // Contadores de la StackingAction: el master los registra igual que los
+  // hilos (la fusión empareja los acumulables por orden de registro)
+  fSecondaries.reserve(kNumStackCategories);
+  fKilled.reserve(kNumStackCategories);
+  fDeferred.reserve(kNumStackCategories);
+  for (G4int i = 0; i < kNumStackCategories; ++i) {
+    G4String name = StackingRules::GetCategoryName(i);
+    fSecondaries.emplace_back("Secondaries_" + name, 0.);
+    fKilled.emplace_back("Killed_" + name, 0.);
+    fDeferred.emplace_back("Deferred_" + name, 0.);
+    accumulableManager->RegisterAccumulable(fSecondaries.back());
+    accumulableManager->RegisterAccumulable(fKilled.back());
+    accumulableManager->RegisterAccumulable(fDeferred.back());
+  }
+  accumulableManager->RegisterAccumulable(fDropped);
 
-  // Crear archivo ROOT
-  analysisManager->OpenFile("NeutronData.root"); // Cambié el nombre para ser más descriptivo
+  // Neutrones eliminados por cada corte de TerminationAction
+  fTerminated.reserve(kNumTerminationCuts);
+  for (G4int i = 0; i < kNumTerminationCuts; ++i) {
+    fTerminated.emplace_back("Terminated_" + TerminationCuts::GetCutName(i), 0.);
+    accumulableManager->RegisterAccumulable(fTerminated.back());
+  }
+  accumulableManager->RegisterAccumulable(&fFluxMesh);
+  accumulableManager->RegisterAccumulable(&fThermalization);
+  accumulableManager->RegisterAccumulable(&fPixels);
+  accumulableManager->RegisterAccumulable(&fPlanes);
+
+  // En modo MT cada hilo (y el master) tiene su propio G4AnalysisManager.
+  // Los histogramas y la ntuple se definen una sola vez por hilo, aquí,
+  // y Geant4 los fusiona en el archivo del master al final del run.
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetDefaultFileType("root");
+  analysisManager->SetVerboseLevel(0);
+  analysisManager->SetNtupleMerging(true);
+  // Con la activación habilitada, la ntuple sólo se escribe si se pide
+  // con /output/ntuple true (los histogramas siguen siempre activos)
+  analysisManager->SetActivation(true);
 
   // --- Crear histograma ---
   // Ajusté los bines. 200,000 era excesivo y consumiría mucha memoria.
@@ -21,12 +93,28 @@ void RunAction::BeginOfRunAction(const G4Run*)
   analysisManager->CreateH1("NeutronEnergy", "Espectro de energia de neutrones (eV)",
                             5000, 0., 5.e6); // 0 a 5 MeV
 
+  // Espectro logarítmico de 1 meV a 10 MeV (100 bines por década). Con la
+  // función log10 y bines lineales el eje es log10(E/eV) y la búsqueda del
+  // bin es una división, no una búsqueda binaria en una lista de bordes.
+  analysisManager->CreateH1("NeutronEnergyLog", "Espectro de energia de neutrones;log10(E/eV)",
+                            1000, 1.e-3*eV, 1.e7*eV, "eV", "log10");
+
+  // Energía vs tiempo de llegada (1 ns a 10 ms) y vs radio del hit en el
+  // detector (hasta 2 cm: la esquina del detector por defecto está a
+  // √2·1 cm); la energía usa el mismo eje log10(E/eV)
+  analysisManager->CreateH2("EnergyVsTime", "Energia vs tiempo de llegada;log10(E/eV);log10(t/ns)",
+                            200, 1.e-3*eV, 1.e7*eV, 140, 1.*ns, 1.e7*ns,
+                            "eV", "ns", "log10", "log10");
+  analysisManager->CreateH2("EnergyVsRadius", "Energia vs radio del hit;log10(E/eV);r (mm)",
+                            200, 1.e-3*eV, 1.e7*eV, 100, 0., 20.*mm,
+                            "eV", "mm", "log10", "none");
+
   // --- Definición de la Ntuple (Tabla) ---
   analysisManager->CreateNtuple("NeutronTracks", "Datos de trazas de neutrones");
 
   // --- Columnas de la Ntuple ---
   // (El orden de creación es el ID de la columna, empezando en 0)
-  
+
   // Información del evento/traza
   analysisManager->CreateNtupleIColumn("EventID");    // Col 0: ID del evento
   analysisManager->CreateNtupleIColumn("TrackID");    // Col 1: ID de la traza
@@ -44,7 +132,7 @@ void RunAction::BeginOfRunAction(const G4Run*)
   // Información de la traza (¡muy útil para termalización!)
   analysisManager->CreateNtupleDColumn("TotalTrackLength_mm"); // Col 8: Longitud total de la traza (en mm)
   analysisManager->CreateNtupleIColumn("NumSteps");            // Col 9: Número de pasos/colisiones
-  
+
   // Información del "final" de la traza
   analysisManager->CreateNtupleSColumn("FinalVolume"); // Col 10: Nombre del volumen donde terminó
   analysisManager->CreateNtupleSColumn("FinalProcess"); // Col 11: Proceso que finalizó la traza
@@ -52,15 +140,153 @@ void RunAction::BeginOfRunAction(const G4Run*)
   analysisManager->CreateNtupleDColumn("DirX");            // Col 12: Componente X de la dirección
   analysisManager->CreateNtupleDColumn("DirY");            // Col 13: Componente Y de la dirección
   analysisManager->CreateNtupleDColumn("DirZ");            // Col 14: Componente Z de la dirección
+  analysisManager->CreateNtupleDColumn("Weight");          // Col 15: Peso de la traza (1 sin muestreo)
 
   analysisManager->FinishNtuple();
+
+  // --- Misma ntuple en formato columnar (mismos IDs de columna) ---
+  // Energías, tiempos y posiciones en float32; volumen y proceso como códigos
+  fColumnar = new ColumnarWriter("NeutronTracks");
+  fColumnar->CreateColumn("EventID", ColumnarWriter::kInt32);
+  fColumnar->CreateColumn("TrackID", ColumnarWriter::kInt32);
+  fColumnar->CreateColumn("ParentID", ColumnarWriter::kInt32);
+  fColumnar->CreateColumn("KineticEnergy_eV", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("FinalTime_ns", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("FinalPosX_mm", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("FinalPosY_mm", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("FinalPosZ_mm", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("TotalTrackLength_mm", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("NumSteps", ColumnarWriter::kInt32);
+  fColumnar->CreateColumn("FinalVolume", ColumnarWriter::kEnum8);
+  fColumnar->CreateColumn("FinalProcess", ColumnarWriter::kEnum8);
+  fColumnar->CreateColumn("DirX", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("DirY", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("DirZ", ColumnarWriter::kFloat32);
+  fColumnar->CreateColumn("Weight", ColumnarWriter::kFloat32);
+
+  fCollisions = new CollisionRecorder();
+}
+
+RunAction::~RunAction()
+{
+  delete fColumnar;
+  delete fCollisions;
+  delete fMessenger;
+}
+
+void RunAction::BeginOfRunAction(const G4Run*)
+{
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetNtupleActivation(0, fNtupleEnabled && !fColumnarOutput);
+
+  // Crear archivo ROOT (los hilos de trabajo escriben en el archivo del master)
+  analysisManager->OpenFile(fFileName + ".root");
+
+  if (fNtupleEnabled && fColumnarOutput) fColumnar->Open(fFileName + "_cols");
+  if (fCollisions->IsEnabled()) fCollisions->Open(fFileName + "_collisions");
+
+  // La malla de flujo sigue al bloque de este run (puede cambiar entre
+  // runs con /detector/ o /sweep/); los hilos comparten la geometría
+  auto detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fFluxMesh.SetExtent(detector->GetParaffinX(), detector->GetParaffinY(),
+                      detector->GetParaffinZ());
+  fThermalization.SetBandEdges(fBandEdges);
+  fPixels.SetShape(detector->GetPixelsX(), detector->GetPixelsY(), GetNumberOfBands());
+  fPlanes.SetGeometry(detector->GetParaffinZ(), fBandEdges);
+
+  G4AccumulableManager::Instance()->Reset();
+
+  if (IsMaster()) fTimer.Start();
+}
+
+G4int RunAction::GetBand(G4double kineticEnergy) const
+{
+  // Banda = número de límites <= E (el límite pertenece a la banda superior)
+  return std::upper_bound(fBandEdges.begin(), fBandEdges.end(), kineticEnergy)
+         - fBandEdges.begin();
+}
+
+void RunAction::AddEventScore(const G4double* bandWeight, G4double detectedWeight)
+{
+  fDetected += detectedWeight;
+  fDetectedSq += detectedWeight*detectedWeight;
+  for (G4int b = 0; b < GetNumberOfBands(); ++b) {
+    if (bandWeight[b] == 0.) continue;
+    fBands[b] += bandWeight[b];
+    fBandsSq[b] += bandWeight[b]*bandWeight[b];
+  }
+  fPixels.EndOfEvent();
+}
+
+void RunAction::CountSecondary(G4int category, G4ClassificationOfNewTrack classification)
+{
+  fSecondaries[category] += 1.;
+  if (classification == fKill)         fKilled[category] += 1.;
+  else if (classification == fWaiting) fDeferred[category] += 1.;
+}
+
+// ------------------------------------------------------------
+// Errores y figura de mérito
+// ------------------------------------------------------------
+// Con N eventos independientes de puntaje x_i, el error de la suma es
+// sqrt(Σx² - (Σx)²/N); sin pesos se reduce al error binomial.
+G4double RunAction::GetDetectedError() const
+{
+  return SumError(fDetected.GetValue(), fDetectedSq.GetValue(), fNumberOfEvents);
+}
+
+G4double RunAction::GetBandError(G4int band) const
+{
+  return SumError(fBands[band].GetValue(), fBandsSq[band].GetValue(), fNumberOfEvents);
+}
+
+G4double RunAction::GetFigureOfMerit(G4int band) const
+{
+  G4double sum = GetBandCount(band);
+  G4double error = GetBandError(band);
+  G4double time = GetRunTime();
+  if (sum <= 0. || error <= 0. || time <= 0.) return 0.;
+  G4double relative = error / sum;
+  return 1. / (relative*relative*time);
+}
+
+G4bool RunAction::SetBandEdges(const std::vector<G4double>& edges)
+{
+  if (G4int(edges.size()) >= kMaxBands ||
+      !std::is_sorted(edges.begin(), edges.end()) ||
+      std::adjacent_find(edges.begin(), edges.end()) != edges.end()) {
+    return false;
+  }
+  fBandEdges = edges;
+  return true;
+}
+
+G4String RunAction::GetBandLabel(G4int band) const
+{
+  std::ostringstream label;
+  G4int nEdges = fBandEdges.size();
+  if (nEdges == 0) {
+    label << "Todas";
+  } else if (band == 0) {
+    label << "E<" << fBandEdges[0]/eV << "eV";
+  } else if (band == nEdges) {
+    label << "E>=" << fBandEdges[nEdges - 1]/eV << "eV";
+  } else {
+    label << fBandEdges[band - 1]/eV << "-" << fBandEdges[band]/eV << "eV";
+  }
+  return label.str();
 }
 
+G4Run* RunAction::GenerateRun()
+{
+  return new ProfileRun();
+}
 
-void RunAction::EndOfRunAction(const G4Run*)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
   auto analysisManager = G4AnalysisManager::Instance();
-  
+
   // Es bueno normalizar el histograma si se desea (opcional)
   // G4double norm = ...;
   // analysisManager->ScaleH1(0, norm); // '0' es el ID del histograma
@@ -68,5 +294,187 @@ void RunAction::EndOfRunAction(const G4Run*)
   analysisManager->Write();
   analysisManager->CloseFile();
 
+  G4bool columnar = fColumnar->IsOpen();
+  fColumnar->Close();
+  G4bool collisions = fCollisions->IsRecording();
+  fCollisions->Close();
+
+  // Suma los conteos de todos los hilos en el master
+  G4AccumulableManager::Instance()->Merge();
+  fNumberOfEvents = run->GetNumberOfEvent();
+
+  if (!IsMaster()) return;
+
+  fTimer.Stop();
+
+  // --- Reporte de rendimiento del run (usado por macros/scaling.py) ---
+  G4int nEvents = run->GetNumberOfEvent();
+  G4double wall = fTimer.GetRealElapsed();
+  G4int nThreads = G4RunManager::GetRunManager()->GetNumberOfThreads();
+
   G4cout << "Archivo ROOT guardado." << G4endl;
+  G4cout << "  Eventos procesados:       " << nEvents << G4endl;
+  G4cout << "  Hilos de trabajo:         " << nThreads << G4endl;
+  G4cout << "  Tiempo del run (Wall):    " << wall << " segundos." << G4endl;
+  if (wall > 0.) {
+    G4cout << "  Eventos/s:                " << nEvents / wall << G4endl;
+  }
+  G4cout << "  Neutrones detectados:     " << GetDetected() << " ± " << GetDetectedError() << G4endl;
+  for (G4int b = 0; b < GetNumberOfBands(); ++b) {
+    G4cout << "    " << std::setw(18) << std::left << GetBandLabel(b) << std::right
+           << GetBandCount(b) << " ± " << GetBandError(b) << G4endl;
+  }
+  G4cout << "  FOM " << GetBandLabel(0) << ":    " << GetFigureOfMerit(0) << " 1/s" << G4endl;
+
+  WriteTallies(GetTallies(), fFileName + "_tallies.csv");
+  fFluxMesh.Write(fFileName, nEvents);
+  fThermalization.Print(nEvents);
+  fThermalization.Write(fFileName, nEvents);
+  if (fPlanes.IsEnabled()) {
+    std::vector<G4String> labels;
+    for (G4int b = 0; b < GetNumberOfBands(); ++b) labels.push_back(GetBandLabel(b));
+    fPlanes.Write(fFileName, nEvents, labels);
+  }
+  if (fPixels.IsEnabled()) {
+    auto detector = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    fPixels.Write(fFileName, nEvents, fBandEdges, detector->GetPixelPitch());
+  }
+  PrintStackCounters();
+  PrintTerminationCounters();
+
+  // Perfil de pasos (sólo con --profile)
+  auto profile = static_cast<const ProfileRun*>(run);
+  if (!profile->IsEmpty()) {
+    profile->Print();
+    profile->Write(fFileName + "_profile.csv");
+    G4cout << "  Perfil guardado en '" << fFileName << "_profile.csv'" << G4endl;
+  }
+
+  // Las partes de los hilos ya están cerradas: se unen en <fileName>_cols/
+  if (columnar) {
+    std::size_t rows = fColumnar->Merge(nThreads);
+    G4cout << "  Ntuple columnar:          " << rows << " filas en '"
+           << fFileName << "_cols/'" << G4endl;
+  }
+  if (collisions) {
+    std::size_t rows = fCollisions->Merge(nThreads);
+    G4cout << "  Historias de colisiones:  " << rows << " colisiones en '"
+           << fFileName << "_collisions/'" << G4endl;
+  }
+}
+
+ColumnarWriter* RunAction::GetColumnarWriter() const
+{
+  return fColumnar->IsOpen() ? fColumnar : nullptr;
+}
+
+void RunAction::SetCompression(G4bool value)
+{
+  fColumnar->SetCompression(value);
+  fCollisions->SetCompression(value);
+}
+
+// ------------------------------------------------------------
+// Resumen compacto de los conteos por banda (<archivo>_tallies.csv)
+// ------------------------------------------------------------
+void RunAction::Tallies::Add(const Tallies& other)
+{
+  events += other.events;
+  time += other.time;
+  detected += other.detected;
+  detectedSq += other.detectedSq;
+  bands.resize(other.bands.size(), 0.);
+  bandsSq.resize(other.bandsSq.size(), 0.);
+  for (std::size_t b = 0; b < other.bands.size(); ++b) {
+    bands[b] += other.bands[b];
+    bandsSq[b] += other.bandsSq[b];
+  }
+}
+
+RunAction::Tallies RunAction::GetTallies() const
+{
+  Tallies tallies;
+  tallies.events = fNumberOfEvents;
+  tallies.time = GetRunTime();
+  tallies.detected = fDetected.GetValue();
+  tallies.detectedSq = fDetectedSq.GetValue();
+  for (G4int b = 0; b < GetNumberOfBands(); ++b) {
+    tallies.bands.push_back(fBands[b].GetValue());
+    tallies.bandsSq.push_back(fBandsSq[b].GetValue());
+  }
+  return tallies;
+}
+
+void RunAction::WriteTallies(const Tallies& tallies, const G4String& fileName) const
+{
+  std::ofstream out(fileName);
+  if (!out) {
+    G4ExceptionDescription ed;
+    ed << "No se pudo escribir el resumen " << fileName;
+    G4Exception("RunAction::WriteTallies", "Run001", JustWarning, ed);
+    return;
+  }
+
+  G4int nEvents = tallies.events;
+  out << "# Eventos: " << nEvents << "\n";
+  out << "# Tiempo_s: " << tallies.time << "\n";
+  out << "Banda,Emin_eV,Emax_eV,Conteos,Error,PorEvento,FOM\n";
+
+  auto writeRow = [&](const G4String& label, G4double eMin, G4double eMax,
+                      G4double n, G4double n2) {
+    G4double error = SumError(n, n2, nEvents);
+    G4double fom = (n > 0. && error > 0. && tallies.time > 0.)
+      ? n*n / (error*error*tallies.time) : 0.;
+    out << label << "," << eMin/eV << "," << eMax/eV << "," << n << "," << error
+        << "," << (nEvents > 0 ? n / nEvents : 0.) << "," << fom << "\n";
+  };
+
+  G4int nEdges = fBandEdges.size();
+  for (G4int b = 0; b <= nEdges && b < G4int(tallies.bands.size()); ++b) {
+    G4double eMin = (b == 0) ? 0. : fBandEdges[b - 1];
+    G4double eMax = (b == nEdges) ? DBL_MAX : fBandEdges[b];
+    writeRow(GetBandLabel(b), eMin, eMax, tallies.bands[b], tallies.bandsSq[b]);
+  }
+  writeRow("Detectados", 0., DBL_MAX, tallies.detected, tallies.detectedSq);
+
+  G4cout << "  Resumen de conteos en '" << fileName << "'" << G4endl;
+}
+
+// ------------------------------------------------------------
+// Reporte de TerminationAction
+// ------------------------------------------------------------
+void RunAction::PrintTerminationCounters() const
+{
+  G4double total = 0.;
+  for (G4int i = 0; i < kNumTerminationCuts; ++i) total += GetTerminated(i);
+  if (total == 0.) return;
+
+  G4cout << "  Neutrones eliminados por corte:" << G4endl;
+  for (G4int i = 0; i < kNumTerminationCuts; ++i) {
+    if (GetTerminated(i) == 0.) continue;
+    G4cout << "    " << std::setw(12) << std::left << TerminationCuts::GetCutName(i) << std::right
+           << std::setw(12) << GetTerminated(i) << G4endl;
+  }
+}
+
+// ------------------------------------------------------------
+// Reporte de la StackingAction
+// ------------------------------------------------------------
+void RunAction::PrintStackCounters() const
+{
+  G4double total = 0.;
+  for (G4int i = 0; i < kNumStackCategories; ++i) total += GetSecondaries(i);
+  if (total == 0.) return;
+
+  G4cout << "  Secundarios (no neutrones):  vistos   eliminados   diferidos" << G4endl;
+  for (G4int i = 0; i < kNumStackCategories; ++i) {
+    if (GetSecondaries(i) == 0.) continue;
+    G4cout << "    " << std::setw(8) << std::left << StackingRules::GetCategoryName(i) << std::right
+           << std::setw(20) << GetSecondaries(i) << std::setw(13) << GetKilled(i)
+           << std::setw(12) << GetDeferred(i) << G4endl;
+  }
+  if (GetDropped() > 0.) {
+    G4cout << "    Diferidos descartados: " << GetDropped() << G4endl;
+  }
 }
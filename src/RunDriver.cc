@@ -0,0 +1,231 @@
+#include "RunDriver.hh"
+#include "RunDriverMessenger.hh"
+#include "Convergence.hh"
+
+#include "G4RunManager.hh"
+#include "G4Run.hh"
+#include "G4UImanager.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+const RunAction* MasterRunAction()
+{
+    return static_cast<const RunAction*>(G4RunManager::GetRunManager()->GetUserRunAction());
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+RunDriver::RunDriver(Convergence* convergence)
+ : fConvergence(convergence),
+   fEvery(100000),
+   fCheckpointFile("checkpoint"),
+   fTotal(0),
+   fChunk(0),
+   fNextRunID(-1)
+{
+    fMessenger = new RunDriverMessenger(this);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+RunDriver::~RunDriver()
+{
+    delete fMessenger;
+}
+
+// ------------------------------------------------------------
+// Run nuevo y continuación
+// ------------------------------------------------------------
+void RunDriver::BeamOn(G4int nEvents)
+{
+    auto runAction = MasterRunAction();
+    fBaseName = runAction->GetFileName();
+    fTotal = nEvents;
+    fChunk = 0;
+    fEdges = runAction->GetBandEdges();
+    fTallies = RunAction::Tallies();
+    Continue();
+}
+
+void RunDriver::Resume()
+{
+    if (!ReadCheckpoint()) return;
+
+    if (fEdges != MasterRunAction()->GetBandEdges()) {
+        G4ExceptionDescription ed;
+        ed << "Los límites de banda actuales no coinciden con los del punto de control "
+           << fCheckpointFile << ".chk; use el mismo /tally/bands.";
+        G4Exception("RunDriver::Resume", "Driver002", JustWarning, ed);
+        return;
+    }
+
+    // Mismos IDs de run que el run sin interrumpir: las semillas por evento
+    // dependen de ellos
+    if (fNextRunID >= 0) {
+        G4RunManager::GetRunManager()->SetRunIDCounter(fNextRunID);
+    }
+    else {
+        G4ExceptionDescription ed;
+        ed << "El punto de control " << fCheckpointFile << ".chk no tiene el ID de run; con "
+           << "/seed/perEvent los tramos restantes no repetirán la secuencia original.";
+        G4Exception("RunDriver::Resume", "Driver004", JustWarning, ed);
+    }
+    G4Random::restoreEngineStatus((fCheckpointFile + ".rndm").c_str());
+    G4cout << "\n🔹 Continuando '" << fBaseName << "' desde el punto de control: "
+           << fTallies.events << "/" << fTotal << " eventos, " << fChunk << " tramos" << G4endl;
+    Continue();
+}
+
+// ------------------------------------------------------------
+// Tramos restantes
+// ------------------------------------------------------------
+void RunDriver::Continue()
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto UImanager = G4UImanager::GetUIpointer();
+    auto runAction = MasterRunAction();
+
+    G4bool aborted = false;
+    while (true) {
+        G4int n = std::min(fEvery, fConvergence->NextBatch(fTallies, fTotal));
+        if (n <= 0) break;
+        G4cout << "\n🔹 Tramo " << fChunk + 1 << ": eventos " << fTallies.events + 1
+               << "-" << fTallies.events + n << " de " << fTotal << G4endl;
+
+        // /output/fileName se reenvía a los hilos en el próximo beamOn
+        UImanager->ApplyCommand("/output/fileName " + PartName(fChunk));
+        runManager->BeamOn(n);
+
+        RunAction::Tallies chunk = runAction->GetTallies();
+        fTallies.Add(chunk);
+        ++fChunk;
+        fNextRunID = runManager->GetCurrentRun()->GetRunID() + 1;
+        WriteCheckpoint();
+
+        // Run abortado (/run/abort): se conserva el punto de control y se para
+        if (chunk.events < n) {
+            G4cout << "⚠️ Tramo incompleto (" << chunk.events << "/" << n
+                   << " eventos): use /driver/resume para continuar." << G4endl;
+            aborted = true;
+            break;
+        }
+    }
+
+    UImanager->ApplyCommand("/output/fileName " + fBaseName);
+    if (aborted) return;
+
+    // --- Totales de todos los tramos ---
+    G4cout << "\n✅ Run completo: " << fTallies.events << " eventos en " << fChunk
+           << " tramos, " << fTallies.time << " s de simulación" << G4endl;
+    fConvergence->Print(fTallies);
+    runAction->WriteTallies(fTallies, fBaseName + "_tallies.csv");
+    G4cout << "  Histogramas y ntuple por tramo en '" << fBaseName << "_part*.root'"
+           << " (unir con: hadd " << fBaseName << ".root " << fBaseName << "_part*.root)" << G4endl;
+    G4cout << "  Flujo, termalización, píxeles y planos por tramo (unir con: python3 flux.py --combine "
+           << fBaseName << " " << fBaseName << "_part*)" << G4endl;
+}
+
+G4String RunDriver::PartName(G4int chunk) const
+{
+    std::ostringstream name;
+    name << fBaseName << "_part" << std::setw(4) << std::setfill('0') << chunk;
+    return name.str();
+}
+
+// ------------------------------------------------------------
+// Punto de control
+// ------------------------------------------------------------
+// Se escribe en archivos temporales y se renombran al final: si el proceso
+// muere a mitad de la escritura queda el punto de control anterior.
+void RunDriver::WriteCheckpoint() const
+{
+    G4String chk = fCheckpointFile + ".chk";
+    G4String rndm = fCheckpointFile + ".rndm";
+
+    G4Random::saveEngineStatus((rndm + ".tmp").c_str());
+
+    std::ofstream out(chk + ".tmp");
+    out << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+    out << "# Punto de control de /driver/beamOn\n"
+        << "base " << fBaseName << "\n"
+        << "total " << fTotal << "\n"
+        << "chunks " << fChunk << "\n"
+        << "runID " << fNextRunID << "\n"
+        << "events " << fTallies.events << "\n"
+        << "time " << fTallies.time << "\n"
+        << "detected " << fTallies.detected << " " << fTallies.detectedSq << "\n"
+        << "edges " << fEdges.size();
+    for (G4double edge : fEdges) out << " " << edge;
+    out << "\n";
+    for (std::size_t b = 0; b < fTallies.bands.size(); ++b) {
+        out << "band " << fTallies.bands[b] << " " << fTallies.bandsSq[b] << "\n";
+    }
+    out.close();
+
+    if (!out || std::rename((rndm + ".tmp").c_str(), rndm.c_str()) != 0 ||
+        std::rename((chk + ".tmp").c_str(), chk.c_str()) != 0) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir el punto de control " << chk;
+        G4Exception("RunDriver::WriteCheckpoint", "Driver001", JustWarning, ed);
+        return;
+    }
+    G4cout << "  Punto de control: " << fTallies.events << "/" << fTotal
+           << " eventos en '" << chk << "'" << G4endl;
+}
+
+G4bool RunDriver::ReadCheckpoint()
+{
+    G4String chk = fCheckpointFile + ".chk";
+    std::ifstream in(chk);
+    if (!in) {
+        G4ExceptionDescription ed;
+        ed << "No se encontró el punto de control " << chk;
+        G4Exception("RunDriver::ReadCheckpoint", "Driver003", JustWarning, ed);
+        return false;
+    }
+
+    RunAction::Tallies tallies;
+    std::vector<G4double> edges;
+    fNextRunID = -1;   // puntos de control anteriores no lo tienen
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        std::string key;
+        is >> key;
+        if (key == "base")          is >> fBaseName;
+        else if (key == "total")    is >> fTotal;
+        else if (key == "chunks")   is >> fChunk;
+        else if (key == "runID")    is >> fNextRunID;
+        else if (key == "events")   is >> tallies.events;
+        else if (key == "time")     is >> tallies.time;
+        else if (key == "detected") is >> tallies.detected >> tallies.detectedSq;
+        else if (key == "edges") {
+            std::size_t n = 0;
+            is >> n;
+            edges.resize(n);
+            for (auto& edge : edges) is >> edge;
+        }
+        else if (key == "band") {
+            G4double sum = 0., sumSq = 0.;
+            is >> sum >> sumSq;
+            tallies.bands.push_back(sum);
+            tallies.bandsSq.push_back(sumSq);
+        }
+    }
+    fEdges = edges;
+    fTallies = tallies;
+    return true;
+}
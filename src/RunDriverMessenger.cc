@@ -0,0 +1,75 @@
+#include "RunDriverMessenger.hh"
+#include "RunDriver.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /driver/
+// ------------------------------------------------------------
+RunDriverMessenger::RunDriverMessenger(RunDriver* driver)
+ : fDriver(driver)
+{
+    // Los tramos se lanzan desde el master
+    fDriverDir = new G4UIdirectory("/driver/", false);
+    fDriverDir->SetGuidance("Runs largos en tramos con puntos de control.");
+
+    fEveryCmd = new G4UIcmdWithAnInteger("/driver/checkpointEvery", this);
+    fEveryCmd->SetGuidance("Eventos por tramo (un punto de control al final de cada uno).");
+    fEveryCmd->SetParameterName("events", false);
+    fEveryCmd->SetRange("events > 0");
+    fEveryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEveryCmd->SetToBeBroadcasted(false);
+
+    fFileCmd = new G4UIcmdWithAString("/driver/checkpointFile", this);
+    fFileCmd->SetGuidance("Nombre del punto de control: <nombre>.chk y <nombre>.rndm.");
+    fFileCmd->SetParameterName("name", false);
+    fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileCmd->SetToBeBroadcasted(false);
+
+    fBeamOnCmd = new G4UIcmdWithAnInteger("/driver/beamOn", this);
+    fBeamOnCmd->SetGuidance("Corre N eventos en tramos, guardando un punto de control por tramo.");
+    fBeamOnCmd->SetParameterName("events", false);
+    fBeamOnCmd->SetRange("events > 0");
+    fBeamOnCmd->AvailableForStates(G4State_Idle);
+    fBeamOnCmd->SetToBeBroadcasted(false);
+
+    fResumeCmd = new G4UIcmdWithoutParameter("/driver/resume", this);
+    fResumeCmd->SetGuidance("Continúa el run desde el último punto de control.");
+    fResumeCmd->SetGuidance("La configuración (geometría, haz, /tally/bands) debe ser la misma.");
+    fResumeCmd->AvailableForStates(G4State_Idle);
+    fResumeCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+RunDriverMessenger::~RunDriverMessenger()
+{
+    delete fEveryCmd;
+    delete fFileCmd;
+    delete fBeamOnCmd;
+    delete fResumeCmd;
+    delete fDriverDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con RunDriver
+// ------------------------------------------------------------
+void RunDriverMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fEveryCmd) {
+        fDriver->SetCheckpointEvery(fEveryCmd->GetNewIntValue(newValue));
+    }
+    else if (command == fFileCmd) {
+        fDriver->SetCheckpointFile(newValue);
+    }
+    else if (command == fBeamOnCmd) {
+        fDriver->BeamOn(fBeamOnCmd->GetNewIntValue(newValue));
+    }
+    else if (command == fResumeCmd) {
+        fDriver->Resume();
+    }
+}
@@ -0,0 +1,136 @@
+#include "RunMessenger.hh"
+#include "RunAction.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+#include <vector>
+
+// ------------------------------------------------------------
+// Constructor: comandos /tally/ y /output/
+// ------------------------------------------------------------
+RunMessenger::RunMessenger(RunAction* runAction)
+ : fRunAction(runAction)
+{
+    fTallyDir = new G4UIdirectory("/tally/");
+    fTallyDir->SetGuidance("Conteos de neutrones transmitidos por banda de energía.");
+
+    // --- Límites de las bandas ---
+    fBandsCmd = new G4UIcmdWithAString("/tally/bands", this);
+    fBandsCmd->SetGuidance("Límites entre bandas de energía, en orden creciente, y la unidad.");
+    fBandsCmd->SetGuidance("  N límites definen N+1 bandas (por defecto: 0.025 0.5 eV).");
+    fBandsCmd->SetParameterName("edges", false);
+    fBandsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Tiempos de termalización ---
+    fThermalizationCmd = new G4UIcmdWithABool("/tally/thermalization", this);
+    fThermalizationCmd->SetGuidance("Mapa energía vs tiempo desde el nacimiento en cada colisión en el bloque");
+    fThermalizationCmd->SetGuidance("y tiempo medio hasta bajar de cada límite de banda (activo por defecto).");
+    fThermalizationCmd->SetParameterName("enable", true);
+    fThermalizationCmd->SetDefaultValue(true);
+    fThermalizationCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fOutputDir = new G4UIdirectory("/output/");
+    fOutputDir->SetGuidance("Archivos de salida del run.");
+
+    // --- Ntuple por neutrón ---
+    fNtupleCmd = new G4UIcmdWithABool("/output/ntuple", this);
+    fNtupleCmd->SetGuidance("Escribe la ntuple NeutronTracks (una fila por neutrón transmitido).");
+    fNtupleCmd->SetGuidance("Desactivada por defecto: sólo se guardan histogramas y conteos.");
+    fNtupleCmd->SetParameterName("enable", true);
+    fNtupleCmd->SetDefaultValue(true);
+    fNtupleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Nombre base de los archivos ---
+    fFileNameCmd = new G4UIcmdWithAString("/output/fileName", this);
+    fFileNameCmd->SetGuidance("Nombre base de la salida: <nombre>.root y <nombre>_tallies.csv.");
+    fFileNameCmd->SetParameterName("fileName", false);
+    fFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Formato de la ntuple ---
+    fFormatCmd = new G4UIcmdWithAString("/output/format", this);
+    fFormatCmd->SetGuidance("Formato de la ntuple por neutrón:");
+    fFormatCmd->SetGuidance("  root: NeutronTracks dentro de <nombre>.root;");
+    fFormatCmd->SetGuidance("  columnar: un archivo binario por columna en <nombre>_cols/");
+    fFormatCmd->SetGuidance("            (float32/int32/uint8, legibles con np.memmap).");
+    fFormatCmd->SetParameterName("format", false);
+    fFormatCmd->SetCandidates("root columnar");
+    fFormatCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Compresión de la salida columnar ---
+    fCompressCmd = new G4UIcmdWithABool("/output/compress", this);
+    fCompressCmd->SetGuidance("Comprime con zlib los bloques de la salida columnar y de las historias");
+    fCompressCmd->SetGuidance("de /collisions/ (sólo si se compiló con zlib). Se leen con");
+    fCompressCmd->SetGuidance("macros/columnar.py, no con np.memmap.");
+    fCompressCmd->SetParameterName("enable", true);
+    fCompressCmd->SetDefaultValue(true);
+    fCompressCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+RunMessenger::~RunMessenger()
+{
+    delete fBandsCmd;
+    delete fThermalizationCmd;
+    delete fTallyDir;
+    delete fNtupleCmd;
+    delete fFileNameCmd;
+    delete fFormatCmd;
+    delete fCompressCmd;
+    delete fOutputDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con RunAction
+// ------------------------------------------------------------
+void RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fBandsCmd) {
+        // "e1 e2 ... unidad": un parámetro de texto final recibe el resto de la línea
+        std::vector<G4String> tokens;
+        std::istringstream is(newValue);
+        G4String token;
+        while (is >> token) tokens.push_back(token);
+
+        G4String unitName = tokens.back();
+        tokens.pop_back();
+        if (G4UnitDefinition::GetCategory(unitName) != "Energy") {
+            G4ExceptionDescription ed;
+            ed << "Falta la unidad de energía en /tally/bands " << newValue;
+            G4Exception("RunMessenger::SetNewValue", "Run002", JustWarning, ed);
+            return;
+        }
+
+        G4double unit = G4UIcommand::ValueOf(unitName);
+        std::vector<G4double> edges;
+        for (const auto& t : tokens) edges.push_back(G4UIcommand::ConvertToDouble(t) * unit);
+
+        if (!fRunAction->SetBandEdges(edges)) {
+            G4ExceptionDescription ed;
+            ed << "Límites de banda inválidos: '" << newValue << "'. Deben ser crecientes"
+               << " y como máximo " << RunAction::kMaxBands - 1 << ".";
+            G4Exception("RunMessenger::SetNewValue", "Run003", JustWarning, ed);
+        }
+    }
+    else if (command == fThermalizationCmd) {
+        fRunAction->SetThermalizationEnabled(fThermalizationCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fNtupleCmd) {
+        fRunAction->SetNtupleEnabled(fNtupleCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fFileNameCmd) {
+        fRunAction->SetFileName(newValue);
+    }
+    else if (command == fFormatCmd) {
+        fRunAction->SetColumnarOutput(newValue == "columnar");
+    }
+    else if (command == fCompressCmd) {
+        fRunAction->SetCompression(fCompressCmd->GetNewBoolValue(newValue));
+    }
+}
@@ -0,0 +1,65 @@
+#include "SeedMessenger.hh"
+#include "EventSeeder.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithABool.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /seed/
+// ------------------------------------------------------------
+SeedMessenger::SeedMessenger(EventSeeder* seeder)
+ : fSeeder(seeder)
+{
+    fSeedDir = new G4UIdirectory("/seed/");
+    fSeedDir->SetGuidance("Semillas por evento: resultados idénticos con cualquier número de hilos o procesos.");
+
+    fPerEventCmd = new G4UIcmdWithABool("/seed/perEvent", this);
+    fPerEventCmd->SetGuidance("Cada evento usa semillas derivadas de (semilla maestra, run, evento).");
+    fPerEventCmd->SetGuidance("Reemplaza a /random/setSeeds para la simulación de los eventos.");
+    fPerEventCmd->SetParameterName("enable", true);
+    fPerEventCmd->SetDefaultValue(true);
+    fPerEventCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // Enteros de 64 bits: se usa un parámetro 'l'
+    fMasterCmd = new G4UIcommand("/seed/master", this);
+    fMasterCmd->SetGuidance("Semilla maestra (por defecto 12345).");
+    fMasterCmd->SetParameter(new G4UIparameter("seed", 'l', false));
+    fMasterCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fOffsetCmd = new G4UIcommand("/seed/eventOffset", this);
+    fOffsetCmd->SetGuidance("Se suma al ID de cada evento: el primer evento de un shard es el");
+    fOffsetCmd->SetGuidance("número de eventos de los shards anteriores (macros/shards.py).");
+    auto offsetPrm = new G4UIparameter("offset", 'l', false);
+    offsetPrm->SetParameterRange("offset >= 0");
+    fOffsetCmd->SetParameter(offsetPrm);
+    fOffsetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+SeedMessenger::~SeedMessenger()
+{
+    delete fPerEventCmd;
+    delete fMasterCmd;
+    delete fOffsetCmd;
+    delete fSeedDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con EventSeeder
+// ------------------------------------------------------------
+void SeedMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fPerEventCmd) {
+        fSeeder->SetEnabled(fPerEventCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fMasterCmd) {
+        fSeeder->SetMasterSeed(G4UIcommand::ConvertToLongInt(newValue));
+    }
+    else if (command == fOffsetCmd) {
+        fSeeder->SetEventOffset(G4UIcommand::ConvertToLongInt(newValue));
+    }
+}
@@ -0,0 +1,119 @@
+#include "SourceMessenger.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor: comandos /source/
+// ------------------------------------------------------------
+SourceMessenger::SourceMessenger(PrimaryGeneratorAction* generator)
+ : fGenerator(generator)
+{
+    fSourceDir = new G4UIdirectory("/source/");
+    fSourceDir->SetGuidance("Espectro y forma de la fuente (centro y eje: /gun/position y /gun/direction).");
+
+    // --- Espectro de energía ---
+    fSpectrumCmd = new G4UIcommand("/source/spectrum", this);
+    fSpectrumCmd->SetGuidance("Espectro de energía tabulado: archivo de dos columnas \"E peso\".");
+    fSpectrumCmd->SetGuidance("  hist: peso del intervalo [E_i, E_i+1) (el último peso no se usa);");
+    fSpectrumCmd->SetGuidance("  lin:  densidad en E_i, interpolada linealmente.");
+    auto filePrm = new G4UIparameter("file", 's', false);
+    fSpectrumCmd->SetParameter(filePrm);
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultValue("MeV");
+    fSpectrumCmd->SetParameter(unitPrm);
+    auto modePrm = new G4UIparameter("interpolation", 's', true);
+    modePrm->SetDefaultValue("hist");
+    modePrm->SetParameterCandidates("hist lin");
+    fSpectrumCmd->SetParameter(modePrm);
+    fSpectrumCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Distribución angular ---
+    fAngularCmd = new G4UIcommand("/source/angular", this);
+    fAngularCmd->SetGuidance("Distribución tabulada de cos θ respecto del eje: archivo \"cosθ peso\".");
+    auto angularFilePrm = new G4UIparameter("file", 's', false);
+    fAngularCmd->SetParameter(angularFilePrm);
+    auto angularModePrm = new G4UIparameter("interpolation", 's', true);
+    angularModePrm->SetDefaultValue("hist");
+    angularModePrm->SetParameterCandidates("hist lin");
+    fAngularCmd->SetParameter(angularModePrm);
+    fAngularCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    // --- Forma ---
+    fShapeCmd = new G4UIcmdWithAString("/source/shape", this);
+    fShapeCmd->SetGuidance("point: en /gun/position; disk: disco perpendicular al eje.");
+    fShapeCmd->SetParameterName("shape", false);
+    fShapeCmd->SetCandidates("point disk");
+    fShapeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fRadiusCmd = new G4UIcmdWithADoubleAndUnit("/source/radius", this);
+    fRadiusCmd->SetGuidance("Radio del disco.");
+    fRadiusCmd->SetParameterName("radius", false);
+    fRadiusCmd->SetRange("radius >= 0.");
+    fRadiusCmd->SetUnitCategory("Length");
+    fRadiusCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fConeCmd = new G4UIcmdWithADoubleAndUnit("/source/coneAngle", this);
+    fConeCmd->SetGuidance("Semiángulo del cono de emisión alrededor del eje (isótropo dentro del cono).");
+    fConeCmd->SetGuidance("  0: haz en la dirección del eje; 180 deg: isótropo.");
+    fConeCmd->SetParameterName("angle", false);
+    fConeCmd->SetUnitCategory("Angle");
+    fConeCmd->SetDefaultUnit("deg");
+    fConeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fResetCmd = new G4UIcmdWithoutParameter("/source/reset", this);
+    fResetCmd->SetGuidance("Vuelve a la fuente puntual monoenergética de /gun/.");
+    fResetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+SourceMessenger::~SourceMessenger()
+{
+    delete fSpectrumCmd;
+    delete fAngularCmd;
+    delete fShapeCmd;
+    delete fRadiusCmd;
+    delete fConeCmd;
+    delete fResetCmd;
+    delete fSourceDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con PrimaryGeneratorAction
+// ------------------------------------------------------------
+void SourceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fSpectrumCmd) {
+        G4String file, unit, mode;
+        std::istringstream is(newValue);
+        is >> file >> unit >> mode;
+        fGenerator->LoadEnergySpectrum(file, G4UIcommand::ValueOf(unit), mode == "lin");
+    }
+    else if (command == fAngularCmd) {
+        G4String file, mode;
+        std::istringstream is(newValue);
+        is >> file >> mode;
+        fGenerator->LoadAngularSpectrum(file, mode == "lin");
+    }
+    else if (command == fShapeCmd) {
+        fGenerator->SetDisk(newValue == "disk");
+    }
+    else if (command == fRadiusCmd) {
+        fGenerator->SetRadius(fRadiusCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fConeCmd) {
+        fGenerator->SetConeAngle(fConeCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fResetCmd) {
+        fGenerator->Reset();
+    }
+}
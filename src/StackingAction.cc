@@ -0,0 +1,41 @@
+#include "StackingAction.hh"
+#include "RunAction.hh"
+
+#include "G4Track.hh"
+#include "G4Neutron.hh"
+#include "G4StackManager.hh"
+
+StackingAction::StackingAction(const StackingRules* rules, RunAction* runAction)
+ : G4UserStackingAction(),
+   fRules(rules),
+   fRunAction(runAction),
+   fNeutron(G4Neutron::Definition())
+{}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    // Primarios y neutrones: siempre a la pila urgente
+    auto particle = track->GetDefinition();
+    if (track->GetParentID() == 0 || particle == fNeutron) return fUrgent;
+
+    StackCategory category = GetCategory(particle);
+    G4ClassificationOfNewTrack classification = fRules->Classify(category, track->GetKineticEnergy());
+    fRunAction->CountSecondary(category, classification);
+    return classification;
+}
+
+// La pila urgente se vació: lo que queda son sólo secundarios diferidos
+// (Geant4 ya los pasó a la pila urgente para la nueva etapa)
+void StackingAction::NewStage()
+{
+    if (!fRules->GetDropDeferred()) return;
+    fRunAction->CountDropped(stackManager->GetNUrgentTrack() + stackManager->GetNWaitingTrack());
+    stackManager->clear();
+}
+
+StackCategory StackingAction::GetCategory(const G4ParticleDefinition* particle)
+{
+    auto it = fCategories.find(particle);
+    if (it != fCategories.end()) return it->second;
+    return fCategories[particle] = StackingRules::GetCategory(particle);
+}
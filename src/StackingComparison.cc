@@ -0,0 +1,48 @@
+#include "StackingComparison.hh"
+#include "StackingRules.hh"
+#include "ModeComparison.hh"
+#include "RunAction.hh"
+
+namespace {
+
+// Secundarios eliminados al crearse más diferidos descartados
+G4double Killed(const RunAction& run)
+{
+    G4double killed = run.GetDropped();
+    for (G4int c = 0; c < kNumStackCategories; ++c) killed += run.GetKilled(c);
+    return killed;
+}
+
+// Secundarios seguidos (no eliminados ni descartados)
+G4double Tracked(const RunAction& run)
+{
+    G4double seen = 0.;
+    for (G4int c = 0; c < kNumStackCategories; ++c) seen += run.GetSecondaries(c);
+    return seen - Killed(run);
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+StackingComparison::StackingComparison(StackingRules* rules)
+ : fRules(rules)
+{}
+
+// ------------------------------------------------------------
+// Ejecución: todos los secundarios y con reglas
+// ------------------------------------------------------------
+// Con reglas razonables la diferencia de conteos es sólo estadística
+void StackingComparison::Run(G4int nEvents, const G4String& outputFile)
+{
+    G4bool saved = fRules->IsEnabled();
+
+    ModeComparison comparison("todos", "con todos los secundarios", "reglas", "con reglas de /stack/",
+                              [this](G4bool on) { fRules->SetEnabled(on); });
+    comparison.AddColumn("SecundariosSeguidos", "Seguidos", Tracked);
+    comparison.AddColumn("SecundariosEliminados", "Eliminados", Killed);
+    comparison.Run(nEvents, outputFile);
+
+    fRules->SetEnabled(saved);
+}
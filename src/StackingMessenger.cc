@@ -0,0 +1,120 @@
+#include "StackingMessenger.hh"
+#include "StackingRules.hh"
+
+#include "StackingComparison.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor: comandos /stack/
+// ------------------------------------------------------------
+StackingMessenger::StackingMessenger(StackingRules* rules)
+ : fRules(rules)
+{
+    // Las reglas son compartidas: sólo el master las modifica
+    fStackDir = new G4UIdirectory("/stack/", false);
+    fStackDir->SetGuidance("Secundarios que no son neutrones (StackingAction).");
+
+    fRuleCmd = new G4UIcommand("/stack/rule", this);
+    fRuleCmd->SetGuidance("Regla para una categoría de secundarios:");
+    fRuleCmd->SetGuidance("  keep: seguirlos; kill: eliminarlos al crearse;");
+    fRuleCmd->SetGuidance("  defer: seguirlos cuando no queden neutrones en el evento.");
+    fRuleCmd->SetGuidance("Con maxE la regla sólo se aplica a secundarios con E < maxE.");
+    auto categoryPrm = new G4UIparameter("category", 's', false);
+    categoryPrm->SetParameterCandidates("gamma e- e+ proton ion other all");
+    fRuleCmd->SetParameter(categoryPrm);
+    auto actionPrm = new G4UIparameter("action", 's', false);
+    actionPrm->SetParameterCandidates("keep kill defer");
+    fRuleCmd->SetParameter(actionPrm);
+    auto maxEPrm = new G4UIparameter("maxE", 'd', true);
+    maxEPrm->SetDefaultValue(-1.);
+    fRuleCmd->SetParameter(maxEPrm);
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultValue("MeV");
+    fRuleCmd->SetParameter(unitPrm);
+    fRuleCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fRuleCmd->SetToBeBroadcasted(false);
+
+    fEnableCmd = new G4UIcmdWithABool("/stack/enable", this);
+    fEnableCmd->SetGuidance("false: se siguen todos los secundarios (las reglas se conservan).");
+    fEnableCmd->SetParameterName("enable", true);
+    fEnableCmd->SetDefaultValue(true);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEnableCmd->SetToBeBroadcasted(false);
+
+    fDropDeferredCmd = new G4UIcmdWithABool("/stack/dropDeferred", this);
+    fDropDeferredCmd->SetGuidance("Descarta los secundarios diferidos en vez de seguirlos al final del evento.");
+    fDropDeferredCmd->SetParameterName("drop", true);
+    fDropDeferredCmd->SetDefaultValue(true);
+    fDropDeferredCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fDropDeferredCmd->SetToBeBroadcasted(false);
+
+    fPrintCmd = new G4UIcmdWithoutParameter("/stack/print", this);
+    fPrintCmd->SetGuidance("Muestra las reglas actuales.");
+    fPrintCmd->SetToBeBroadcasted(false);
+
+    fCompareCmd = new G4UIcmdWithAnInteger("/stack/compare", this);
+    fCompareCmd->SetGuidance("Corre N eventos siguiendo todos los secundarios y N con las reglas,");
+    fCompareCmd->SetGuidance("y compara el tiempo y los conteos por banda.");
+    fCompareCmd->SetParameterName("events", false);
+    fCompareCmd->SetRange("events > 0");
+    fCompareCmd->AvailableForStates(G4State_Idle);
+    fCompareCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+StackingMessenger::~StackingMessenger()
+{
+    delete fRuleCmd;
+    delete fEnableCmd;
+    delete fDropDeferredCmd;
+    delete fPrintCmd;
+    delete fCompareCmd;
+    delete fStackDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con StackingRules
+// ------------------------------------------------------------
+void StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fRuleCmd) {
+        G4String category, actionName, unit;
+        G4double maxE;
+        std::istringstream is(newValue);
+        is >> category >> actionName >> maxE >> unit;
+
+        G4ClassificationOfNewTrack action = fUrgent;
+        if (actionName == "kill")       action = fKill;
+        else if (actionName == "defer") action = fWaiting;
+        G4double maxEnergy = (maxE > 0.) ? maxE*G4UIcommand::ValueOf(unit) : DBL_MAX;
+
+        for (G4int i = 0; i < kNumStackCategories; ++i) {
+            if (category == "all" || category == StackingRules::GetCategoryName(i)) {
+                fRules->SetRule(StackCategory(i), action, maxEnergy);
+            }
+        }
+    }
+    else if (command == fEnableCmd) {
+        fRules->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fDropDeferredCmd) {
+        fRules->SetDropDeferred(fDropDeferredCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fPrintCmd) {
+        fRules->Print();
+    }
+    else if (command == fCompareCmd) {
+        StackingComparison comparison(fRules);
+        comparison.Run(fCompareCmd->GetNewIntValue(newValue));
+    }
+}
@@ -0,0 +1,78 @@
+#include "StackingRules.hh"
+#include "StackingMessenger.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Proton.hh"
+#include "G4UnitsTable.hh"
+
+// ------------------------------------------------------------
+// Constructor: sin reglas, todos los secundarios se siguen
+// ------------------------------------------------------------
+StackingRules::StackingRules()
+ : fEnabled(true),
+   fDropDeferred(false)
+{
+    for (G4int i = 0; i < kNumStackCategories; ++i) {
+        fAction[i] = fUrgent;
+        fMaxEnergy[i] = DBL_MAX;
+    }
+    fMessenger = new StackingMessenger(this);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+StackingRules::~StackingRules()
+{
+    delete fMessenger;
+}
+
+void StackingRules::SetRule(StackCategory category, G4ClassificationOfNewTrack action,
+                            G4double maxEnergy)
+{
+    fAction[category] = action;
+    fMaxEnergy[category] = maxEnergy;
+}
+
+void StackingRules::Print() const
+{
+    G4cout << "\n Reglas de la StackingAction" << (fEnabled ? "" : " (desactivadas)") << ":" << G4endl;
+    for (G4int i = 0; i < kNumStackCategories; ++i) {
+        G4String action = (fAction[i] == fKill) ? "eliminar" :
+                          (fAction[i] == fWaiting) ? "diferir" : "mantener";
+        G4cout << "   " << GetCategoryName(i) << ": " << action;
+        if (fAction[i] != fUrgent && fMaxEnergy[i] < DBL_MAX) {
+            G4cout << " si E < " << G4BestUnit(fMaxEnergy[i], "Energy");
+        }
+        G4cout << G4endl;
+    }
+    if (fDropDeferred) G4cout << "   (los diferidos se descartan)" << G4endl;
+}
+
+// ------------------------------------------------------------
+// Categorías
+// ------------------------------------------------------------
+StackCategory StackingRules::GetCategory(const G4ParticleDefinition* particle)
+{
+    if (particle == G4Gamma::Definition())    return kGammaStack;
+    if (particle == G4Electron::Definition()) return kElectronStack;
+    if (particle == G4Positron::Definition()) return kPositronStack;
+    if (particle == G4Proton::Definition())   return kProtonStack;
+    if (particle->GetParticleType() == "nucleus") return kIonStack;
+    return kOtherStack;
+}
+
+G4String StackingRules::GetCategoryName(G4int category)
+{
+    switch (category) {
+        case kGammaStack:    return "gamma";
+        case kElectronStack: return "e-";
+        case kPositronStack: return "e+";
+        case kProtonStack:   return "proton";
+        case kIonStack:      return "ion";
+        default:             return "other";
+    }
+}
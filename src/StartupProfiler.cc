@@ -0,0 +1,85 @@
+#include "StartupProfiler.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4StateManager.hh"
+
+std::atomic<G4bool> StartupProfiler::fFirstEventDone(false);
+StartupProfiler::Clock::time_point StartupProfiler::fFirstEventEnd;
+
+// ------------------------------------------------------------
+// Constructor: se registra como observador de estados
+// ------------------------------------------------------------
+StartupProfiler::StartupProfiler(const DetectorConstruction* detector)
+ : G4VStateDependent(),
+   fDetector(detector),
+   fStart(Clock::now()),
+   fInitialize(0.),
+   fTables(0.),
+   fInitPhases(0),
+   fPrinted(false)
+{}
+
+G4double StartupProfiler::Seconds(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<G4double>(to - from).count();
+}
+
+// ------------------------------------------------------------
+// Primer evento terminado (en cualquier hilo)
+// ------------------------------------------------------------
+void StartupProfiler::MarkEventEnd()
+{
+    if (fFirstEventDone.load(std::memory_order_relaxed)) return;
+
+    G4bool expected = false;
+    if (fFirstEventDone.compare_exchange_strong(expected, true)) {
+        fFirstEventEnd = Clock::now();
+    }
+}
+
+// ------------------------------------------------------------
+// Transiciones de estado
+// ------------------------------------------------------------
+// La primera fase Init es /run/initialize (geometría + lista de física);
+// la segunda es la construcción de tablas físicas del primer run (en modo
+// MT ocurre dentro de /run/initialize, en el run "falso" del master).
+G4bool StartupProfiler::Notify(G4ApplicationState requestedState)
+{
+    G4ApplicationState current = G4StateManager::GetStateManager()->GetCurrentState();
+    Clock::time_point now = Clock::now();
+
+    if (requestedState == G4State_Init && current != G4State_Init) {
+        fInitStart = now;
+    }
+    else if (current == G4State_Init && requestedState == G4State_Idle) {
+        if (fInitPhases == 0)      fInitialize = Seconds(fInitStart, now);
+        else if (fInitPhases == 1) fTables = Seconds(fInitStart, now);
+        ++fInitPhases;
+    }
+    else if (requestedState == G4State_GeomClosed && !fFirstEventDone.load()) {
+        fRunStart = now;
+    }
+    else if (requestedState == G4State_Idle && !fPrinted && fFirstEventDone.load()) {
+        // Fin del primer run con eventos
+        Print();
+        fPrinted = true;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// Reporte
+// ------------------------------------------------------------
+void StartupProfiler::Print() const
+{
+    G4double geometry = fDetector->GetConstructionTime();
+
+    G4cout << "\n------------------------------------------------------------" << G4endl;
+    G4cout << "  Tiempos de arranque (s)" << G4endl;
+    G4cout << "  Arranque geometría:             " << geometry << G4endl;
+    G4cout << "  Arranque física:                " << fInitialize - geometry << G4endl;
+    G4cout << "  Arranque tablas físicas + HP:   " << fTables << G4endl;
+    G4cout << "  Arranque primer evento:         " << Seconds(fRunStart, fFirstEventEnd) << G4endl;
+    G4cout << "  Arranque total:                 " << Seconds(fStart, fFirstEventEnd) << G4endl;
+    G4cout << "------------------------------------------------------------" << G4endl;
+}
@@ -0,0 +1,105 @@
+#include "StepLimitComparison.hh"
+#include "DetectorConstruction.hh"
+#include "RunAction.hh"
+
+#include "G4RunManager.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+namespace {
+
+struct PolicyResult {
+    StepLimitPolicy policy;
+    G4double rate;
+    std::vector<G4double> bands;  // detectados y conteos por banda
+};
+
+// Diferencia entre conteos de Poisson en unidades de sigma
+G4double ZScore(G4double a, G4double b)
+{
+    return (a + b > 0.) ? (a - b) / std::sqrt(a + b) : 0.;
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+StepLimitComparison::StepLimitComparison(DetectorConstruction* detector)
+ : fDetector(detector)
+{}
+
+// ------------------------------------------------------------
+// Ejecución: none, boundary y fixed con los mismos eventos
+// ------------------------------------------------------------
+void StepLimitComparison::Run(G4int nEvents, const G4String& outputFile)
+{
+    auto runManager = G4RunManager::GetRunManager();
+    auto runAction = static_cast<const RunAction*>(runManager->GetUserRunAction());
+
+    // Políticas actuales, para restaurarlas al final
+    StepLimitPolicy saved[kNumStepLimitVolumes];
+    for (G4int v = 0; v < kNumStepLimitVolumes; ++v) {
+        saved[v] = fDetector->GetStepLimitPolicy(StepLimitVolume(v));
+    }
+
+    const StepLimitPolicy policies[3] = {kNoStepLimit, kBoundaryStepLimit, kFixedStepLimit};
+    std::vector<PolicyResult> results;
+
+    for (auto policy : policies) {
+        G4cout << "\n🔹 Límite de paso '" << DetectorConstruction::GetStepLimitPolicyName(policy)
+               << "' en todos los volúmenes, " << nEvents << " eventos" << G4endl;
+        for (G4int v = 0; v < kNumStepLimitVolumes; ++v) {
+            fDetector->SetStepLimitPolicy(StepLimitVolume(v), policy);
+        }
+
+        runManager->BeamOn(nEvents);
+
+        PolicyResult r;
+        r.policy = policy;
+        G4double time = runAction->GetRunTime();
+        r.rate = (time > 0.) ? nEvents / time : 0.;
+        r.bands.push_back(runAction->GetDetected());
+        for (G4int b = 0; b < runAction->GetNumberOfBands(); ++b) {
+            r.bands.push_back(runAction->GetBandCount(b));
+        }
+        results.push_back(r);
+    }
+
+    for (G4int v = 0; v < kNumStepLimitVolumes; ++v) {
+        fDetector->SetStepLimitPolicy(StepLimitVolume(v), saved[v]);
+    }
+
+    // --- Reporte: la referencia es "fixed" (el paso más fino) ---
+    const PolicyResult& ref = results.back();
+    std::ofstream out(outputFile);
+    out << "Politica,EventosPorSegundo,Detectados";
+    G4cout << "\n Política     Eventos/s  Detectados";
+    for (G4int b = 0; b < runAction->GetNumberOfBands(); ++b) {
+        out << "," << runAction->GetBandLabel(b);
+        G4cout << std::setw(12) << runAction->GetBandLabel(b);
+    }
+    out << ",ZMax\n";
+    G4cout << "   |z| máx" << G4endl;
+
+    for (const auto& r : results) {
+        G4double zMax = 0.;
+        for (std::size_t b = 0; b < r.bands.size(); ++b) {
+            zMax = std::max(zMax, std::abs(ZScore(r.bands[b], ref.bands[b])));
+        }
+        G4String name = DetectorConstruction::GetStepLimitPolicyName(r.policy);
+        G4cout << " " << std::setw(9) << name << std::setw(13) << r.rate;
+        for (auto b : r.bands) G4cout << std::setw(12) << b;
+        G4cout << std::setw(10) << zMax << (zMax < 3. ? "" : "  ⚠️") << G4endl;
+
+        out << name << "," << r.rate;
+        for (auto b : r.bands) out << "," << b;
+        out << "," << zMax << "\n";
+    }
+    G4cout << " (|z| < 3: espectro compatible con 'fixed' dentro de la estadística)" << G4endl;
+    G4cout << "✅ Comparación guardada en '" << outputFile << "'" << G4endl;
+}
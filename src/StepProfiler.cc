@@ -0,0 +1,38 @@
+#include "StepProfiler.hh"
+#include "ProfileRun.hh"
+
+#include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+// ------------------------------------------------------------
+// Inicio de traza: cuenta la traza y reinicia el reloj
+// ------------------------------------------------------------
+void StepProfiler::StartTrack(const G4Track* track)
+{
+    // El run actual es el ProfileRun de este hilo (RunAction::GenerateRun)
+    fRun = static_cast<ProfileRun*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+
+    auto volume = track->GetVolume();
+    fRun->AddTrack(volume ? volume->GetLogicalVolume() : nullptr,
+                   track->GetDefinition(), track->GetCreatorProcess());
+    fLast = Clock::now();
+}
+
+// ------------------------------------------------------------
+// Paso: tiempo desde el paso anterior
+// ------------------------------------------------------------
+void StepProfiler::UserSteppingAction(const G4Step* step)
+{
+    Clock::time_point now = Clock::now();
+    G4double seconds = std::chrono::duration<G4double>(now - fLast).count();
+
+    auto volume = step->GetPreStepPoint()->GetPhysicalVolume();
+    fRun->AddStep(volume ? volume->GetLogicalVolume() : nullptr,
+                  step->GetTrack()->GetDefinition(),
+                  step->GetPostStepPoint()->GetProcessDefinedStep(), seconds);
+
+    // El reloj se vuelve a leer para no cargarle el propio conteo al paso siguiente
+    fLast = Clock::now();
+}
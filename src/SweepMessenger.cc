@@ -0,0 +1,130 @@
+#include "SweepMessenger.hh"
+#include "GeometrySweep.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+// ------------------------------------------------------------
+// Constructor: comandos /detector/sweep/
+// ------------------------------------------------------------
+SweepMessenger::SweepMessenger(GeometrySweep* sweep)
+ : fSweep(sweep)
+{
+    // Sólo el master ejecuta el barrido: no se reenvía a los hilos
+    fSweepDir = new G4UIdirectory("/detector/sweep/", false);
+    fSweepDir->SetGuidance("Barrido de geometrías del bloque de parafina en un solo proceso.");
+
+    // --- Rangos por eje ---
+    const char* axisName[3] = {"X", "Y", "Z"};
+    for (G4int i = 0; i < 3; ++i) {
+        G4String path = G4String("/detector/sweep/range") + axisName[i];
+        fRangeCmd[i] = new G4UIcommand(path, this);
+        fRangeCmd[i]->SetGuidance("Rango de medias longitudes del bloque: min max paso unidad.");
+
+        auto minPrm = new G4UIparameter("min", 'd', false);
+        fRangeCmd[i]->SetParameter(minPrm);
+        auto maxPrm = new G4UIparameter("max", 'd', false);
+        fRangeCmd[i]->SetParameter(maxPrm);
+        auto stepPrm = new G4UIparameter("step", 'd', false);
+        stepPrm->SetParameterRange("step > 0.");
+        fRangeCmd[i]->SetParameter(stepPrm);
+        auto unitPrm = new G4UIparameter("unit", 's', true);
+        unitPrm->SetDefaultValue("cm");
+        fRangeCmd[i]->SetParameter(unitPrm);
+
+        fRangeCmd[i]->AvailableForStates(G4State_PreInit, G4State_Idle);
+        fRangeCmd[i]->SetToBeBroadcasted(false);
+    }
+
+    // --- Archivo de puntos ---
+    fFileCmd = new G4UIcmdWithAString("/detector/sweep/file", this);
+    fFileCmd->SetGuidance("Lee los puntos del barrido de un archivo (X Y Z en cm por línea).");
+    fFileCmd->SetParameterName("fileName", false);
+    fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fFileCmd->SetToBeBroadcasted(false);
+
+    // --- Eventos por punto ---
+    fEventsCmd = new G4UIcmdWithAnInteger("/detector/sweep/events", this);
+    fEventsCmd->SetGuidance("Número de eventos por punto del barrido.");
+    fEventsCmd->SetParameterName("events", false);
+    fEventsCmd->SetRange("events > 0");
+    fEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEventsCmd->SetToBeBroadcasted(false);
+
+    // --- Tabla de resultados ---
+    fOutputCmd = new G4UIcmdWithAString("/detector/sweep/output", this);
+    fOutputCmd->SetGuidance("Archivo CSV donde se agregan los resultados.");
+    fOutputCmd->SetParameterName("fileName", false);
+    fOutputCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fOutputCmd->SetToBeBroadcasted(false);
+
+    // --- Posición del cañón ---
+    fGunOffsetCmd = new G4UIcmdWithADoubleAndUnit("/detector/sweep/gunOffset", this);
+    fGunOffsetCmd->SetGuidance("Distancia del cañón a la cara de entrada de la parafina.");
+    fGunOffsetCmd->SetParameterName("offset", false);
+    fGunOffsetCmd->SetUnitCategory("Length");
+    fGunOffsetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fGunOffsetCmd->SetToBeBroadcasted(false);
+
+    // --- Ejecutar ---
+    fRunCmd = new G4UIcmdWithoutParameter("/detector/sweep/run", this);
+    fRunCmd->SetGuidance("Ejecuta el barrido (requiere /run/initialize).");
+    fRunCmd->AvailableForStates(G4State_Idle);
+    fRunCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+SweepMessenger::~SweepMessenger()
+{
+    for (auto cmd : fRangeCmd) delete cmd;
+    delete fFileCmd;
+    delete fEventsCmd;
+    delete fOutputCmd;
+    delete fGunOffsetCmd;
+    delete fRunCmd;
+    delete fSweepDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con GeometrySweep
+// ------------------------------------------------------------
+void SweepMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    for (G4int i = 0; i < 3; ++i) {
+        if (command == fRangeCmd[i]) {
+            G4double min, max, step;
+            G4String unit;
+            std::istringstream is(newValue);
+            is >> min >> max >> step >> unit;
+            G4double u = G4UIcommand::ValueOf(unit);
+            fSweep->SetRange(i, min*u, max*u, step*u);
+            return;
+        }
+    }
+
+    if (command == fFileCmd) {
+        fSweep->LoadFile(newValue);
+    }
+    else if (command == fEventsCmd) {
+        fSweep->SetEvents(fEventsCmd->GetNewIntValue(newValue));
+    }
+    else if (command == fOutputCmd) {
+        fSweep->SetOutputFile(newValue);
+    }
+    else if (command == fGunOffsetCmd) {
+        fSweep->SetGunOffset(fGunOffsetCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fRunCmd) {
+        fSweep->Run();
+    }
+}
@@ -0,0 +1,74 @@
+#include "TabulatedSpectrum.hh"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+// ------------------------------------------------------------
+// Lectura del archivo
+// ------------------------------------------------------------
+G4bool TabulatedSpectrum::Load(const G4String& fileName, G4double unit, Interpolation interpolation)
+{
+    std::ifstream in(fileName);
+    if (!in) return false;
+
+    std::vector<G4double> x, y;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        G4double xi, yi;
+        if (!(is >> xi >> yi)) continue;
+        if (yi < 0. || (!x.empty() && xi*unit <= x.back())) return false;
+        x.push_back(xi*unit);
+        y.push_back(yi);
+    }
+    if (x.size() < 2) return false;
+
+    // Peso de cada intervalo y valor medio
+    std::vector<G4double> weights(x.size() - 1);
+    G4double total = 0., moment = 0.;
+    for (std::size_t i = 0; i + 1 < x.size(); ++i) {
+        G4double width = x[i + 1] - x[i];
+        weights[i] = (interpolation == kHistogram) ? y[i] : 0.5*(y[i] + y[i + 1])*width;
+        total += weights[i];
+        moment += weights[i] * 0.5*(x[i] + x[i + 1]);
+    }
+    if (total <= 0.) return false;
+
+    fX = x;
+    fY = y;
+    fInterpolation = interpolation;
+    fTable.Build(weights);
+    fMean = moment / total;
+    return true;
+}
+
+void TabulatedSpectrum::Clear()
+{
+    fX.clear();
+    fY.clear();
+    fTable = AliasTable();
+    fMean = 0.;
+}
+
+// ------------------------------------------------------------
+// Muestreo
+// ------------------------------------------------------------
+G4double TabulatedSpectrum::Sample(G4double u1, G4double u2) const
+{
+    std::size_t i = fTable.Sample(u1);
+    G4double x0 = fX[i], x1 = fX[i + 1];
+
+    // Densidad lineal f0 + (f1 - f0) t en el intervalo: se invierte la
+    // acumulada f0 t + (f1 - f0) t²/2 = u (f0 + f1)/2
+    G4double t = u2;
+    if (fInterpolation == kLinear) {
+        G4double f0 = fY[i], f1 = fY[i + 1];
+        G4double df = f1 - f0;
+        if (std::abs(df) > 1.e-6*(f0 + f1)) {
+            t = (std::sqrt(f0*f0 + u2*(f1*f1 - f0*f0)) - f0) / df;
+        }
+    }
+    return x0 + t*(x1 - x0);
+}
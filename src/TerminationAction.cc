@@ -0,0 +1,119 @@
+#include "TerminationAction.hh"
+#include "TerminationCuts.hh"
+#include "RunAction.hh"
+#include "StepProfiler.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4Neutron.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Método de las placas: la semirrecta p + t·d (t >= 0) cruza la caja
+G4bool HitsBox(const G4ThreeVector& p, const G4ThreeVector& d,
+               const G4ThreeVector& center, const G4ThreeVector& half)
+{
+    G4double t0 = 0., t1 = DBL_MAX;
+    for (G4int k = 0; k < 3; ++k) {
+        G4double q = p[k] - center[k];
+        if (d[k] == 0.) {
+            if (std::abs(q) > half[k]) return false;
+            continue;
+        }
+        G4double tA = (-half[k] - q) / d[k];
+        G4double tB = (half[k] - q) / d[k];
+        if (tA > tB) std::swap(tA, tB);
+        t0 = std::max(t0, tA);
+        t1 = std::min(t1, tB);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+TerminationAction::TerminationAction(const TerminationCuts* cuts, RunAction* runAction,
+                                     StepProfiler* profiler)
+ : G4UserSteppingAction(),
+   fCuts(cuts),
+   fRunAction(runAction),
+   fProfiler(profiler),
+   fNeutron(G4Neutron::Definition())
+{
+    // Los hilos comparten la geometría del master
+    fDetector = static_cast<const DetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+}
+
+TerminationAction::~TerminationAction()
+{
+    delete fProfiler;
+}
+
+// ------------------------------------------------------------
+// Paso: cortes y perfil
+// ------------------------------------------------------------
+void TerminationAction::UserSteppingAction(const G4Step* step)
+{
+    auto track = step->GetTrack();
+    if (fCuts->IsActive() && track->GetDefinition() == fNeutron
+        && track->GetTrackStatus() == fAlive) {
+        G4int cut = Check(step);
+        if (cut >= 0) {
+            track->SetTrackStatus(fStopAndKill);
+            fRunAction->CountTerminated(cut);
+        }
+    }
+
+    if (fProfiler) fProfiler->UserSteppingAction(step);
+}
+
+G4int TerminationAction::Check(const G4Step* step)
+{
+    auto pre = step->GetPreStepPoint();
+    auto post = step->GetPostStepPoint();
+
+    // TransmittedSD registra el punto previo de un paso que entra al
+    // detector: en ese mismo paso el neutrón ya está contado
+    if (fCuts->GetKillScored() && pre->GetStepStatus() == fGeomBoundary) {
+        if (!fScoringSD) {
+            fScoringSD = G4SDManager::GetSDMpointer()->FindSensitiveDetector("TransmittedSD", false);
+        }
+        if (fScoringSD && pre->GetSensitiveDetector() == fScoringSD) return kScoredCut;
+    }
+
+    if (post->GetKineticEnergy() < fCuts->GetMinEnergy()) return kEnergyCut;
+    if (post->GetGlobalTime() > fCuts->GetMaxTime()) return kTimeCut;
+
+    // Aceptancia: sólo en el aire del propio mundo (volumen sin madre)
+    if (fCuts->HasAcceptance()) {
+        auto volume = post->GetPhysicalVolume();
+        if (volume && !volume->GetMotherLogical()
+            && !InAcceptance(post->GetPosition(), post->GetMomentumDirection())) {
+            return kAcceptanceCut;
+        }
+    }
+    return -1;
+}
+
+// El bloque es convexo: un neutrón en el aire que no apunta al bloque ni al
+// detector (agrandado en el margen) sólo volvería por dispersión en el aire
+G4bool TerminationAction::InAcceptance(const G4ThreeVector& p, const G4ThreeVector& d) const
+{
+    G4ThreeVector block(fDetector->GetParaffinX(), fDetector->GetParaffinY(), fDetector->GetParaffinZ());
+    if (HitsBox(p, d, G4ThreeVector(), block)) return true;
+
+    G4double margin = fCuts->GetAcceptanceMargin();
+    G4ThreeVector detector = fDetector->GetDetectorHalfSize() + G4ThreeVector(margin, margin, margin);
+    return HitsBox(p, d, G4ThreeVector(0., 0., fDetector->GetDetectorZ()), detector);
+}
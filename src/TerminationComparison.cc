@@ -0,0 +1,32 @@
+#include "TerminationComparison.hh"
+#include "TerminationCuts.hh"
+#include "ModeComparison.hh"
+#include "RunAction.hh"
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+TerminationComparison::TerminationComparison(TerminationCuts* cuts)
+ : fCuts(cuts)
+{}
+
+// ------------------------------------------------------------
+// Ejecución: sin cortes y con cortes
+// ------------------------------------------------------------
+// Sin sesgo la diferencia de conteos es sólo estadística (/cuts/killScored
+// sí los cambia si los neutrones vuelven a entrar al detector)
+void TerminationComparison::Run(G4int nEvents, const G4String& outputFile)
+{
+    G4bool saved = fCuts->IsEnabled();
+
+    ModeComparison comparison("sin", "sin cortes", "cortes", "con cortes de /cuts/",
+                              [this](G4bool on) { fCuts->SetEnabled(on); });
+    for (G4int c = 0; c < kNumTerminationCuts; ++c) {
+        G4String name = TerminationCuts::GetCutName(c);
+        comparison.AddColumn("Corte_" + name, name,
+                             [c](const RunAction& run) { return run.GetTerminated(c); });
+    }
+    comparison.Run(nEvents, outputFile);
+
+    fCuts->SetEnabled(saved);
+}
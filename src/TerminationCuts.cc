@@ -0,0 +1,54 @@
+#include "TerminationCuts.hh"
+#include "TerminationMessenger.hh"
+
+#include "G4UnitsTable.hh"
+
+// ------------------------------------------------------------
+// Constructor: sin cortes
+// ------------------------------------------------------------
+TerminationCuts::TerminationCuts()
+{
+    fMessenger = new TerminationMessenger(this);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+TerminationCuts::~TerminationCuts()
+{
+    delete fMessenger;
+}
+
+G4bool TerminationCuts::IsActive() const
+{
+    return GetKillScored() || GetMinEnergy() > 0. || GetMaxTime() < DBL_MAX || HasAcceptance();
+}
+
+void TerminationCuts::Print() const
+{
+    G4cout << "\n Cortes de terminación de neutrones" << (fEnabled ? "" : " (desactivados)") << ":" << G4endl;
+    G4cout << "   " << GetCutName(kScoredCut) << ": " << (fKillScored ? "sí" : "no") << G4endl;
+    G4cout << "   " << GetCutName(kEnergyCut) << ": ";
+    if (fMinEnergy > 0.) G4cout << "E < " << G4BestUnit(fMinEnergy, "Energy") << G4endl;
+    else G4cout << "no" << G4endl;
+    G4cout << "   " << GetCutName(kTimeCut) << ": ";
+    if (fMaxTime < DBL_MAX) G4cout << "t > " << G4BestUnit(fMaxTime, "Time") << G4endl;
+    else G4cout << "no" << G4endl;
+    G4cout << "   " << GetCutName(kAcceptanceCut) << ": ";
+    if (fAcceptanceMargin >= 0.) {
+        G4cout << "margen " << G4BestUnit(fAcceptanceMargin, "Length") << G4endl;
+    } else {
+        G4cout << "no" << G4endl;
+    }
+}
+
+G4String TerminationCuts::GetCutName(G4int cut)
+{
+    switch (cut) {
+        case kScoredCut:     return "registrado";
+        case kEnergyCut:     return "energia";
+        case kTimeCut:       return "tiempo";
+        case kAcceptanceCut: return "aceptancia";
+        default:             return "otro";
+    }
+}
@@ -0,0 +1,121 @@
+#include "TerminationMessenger.hh"
+#include "TerminationCuts.hh"
+
+#include "TerminationComparison.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+// ------------------------------------------------------------
+// Constructor: comandos /cuts/
+// ------------------------------------------------------------
+TerminationMessenger::TerminationMessenger(TerminationCuts* cuts)
+ : fCuts(cuts)
+{
+    // Los cortes son compartidos: sólo el master los modifica
+    fCutsDir = new G4UIdirectory("/cuts/", false);
+    fCutsDir->SetGuidance("Cortes que terminan neutrones (TerminationAction).");
+
+    fKillScoredCmd = new G4UIcmdWithABool("/cuts/killScored", this);
+    fKillScoredCmd->SetGuidance("Elimina cada neutrón en cuanto el detector lo registra.");
+    fKillScoredCmd->SetGuidance("Sin el corte, un neutrón que vuelve a entrar al detector se cuenta otra vez.");
+    fKillScoredCmd->SetParameterName("kill", true);
+    fKillScoredCmd->SetDefaultValue(true);
+    fKillScoredCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fKillScoredCmd->SetToBeBroadcasted(false);
+
+    fMinEnergyCmd = new G4UIcmdWithADoubleAndUnit("/cuts/minEnergy", this);
+    fMinEnergyCmd->SetGuidance("Elimina los neutrones con energía menor (0: sin piso).");
+    fMinEnergyCmd->SetParameterName("energy", false);
+    fMinEnergyCmd->SetRange("energy >= 0.");
+    fMinEnergyCmd->SetUnitCategory("Energy");
+    fMinEnergyCmd->SetDefaultUnit("eV");
+    fMinEnergyCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMinEnergyCmd->SetToBeBroadcasted(false);
+
+    fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/cuts/maxTime", this);
+    fMaxTimeCmd->SetGuidance("Elimina los neutrones con tiempo global mayor (0: sin límite).");
+    fMaxTimeCmd->SetParameterName("time", false);
+    fMaxTimeCmd->SetRange("time >= 0.");
+    fMaxTimeCmd->SetUnitCategory("Time");
+    fMaxTimeCmd->SetDefaultUnit("us");
+    fMaxTimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fMaxTimeCmd->SetToBeBroadcasted(false);
+
+    fAcceptanceCmd = new G4UIcmdWithADoubleAndUnit("/cuts/acceptance", this);
+    fAcceptanceCmd->SetGuidance("Elimina los neutrones en el aire del mundo cuya línea recta no cruza el");
+    fAcceptanceCmd->SetGuidance("bloque ni el detector agrandado en el margen dado (negativo: sin corte).");
+    fAcceptanceCmd->SetGuidance("Sólo la dispersión en el aire podría devolverlos al detector.");
+    fAcceptanceCmd->SetParameterName("margin", false);
+    fAcceptanceCmd->SetUnitCategory("Length");
+    fAcceptanceCmd->SetDefaultUnit("cm");
+    fAcceptanceCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fAcceptanceCmd->SetToBeBroadcasted(false);
+
+    fEnableCmd = new G4UIcmdWithABool("/cuts/enable", this);
+    fEnableCmd->SetGuidance("false: no se aplica ningún corte (la configuración se conserva).");
+    fEnableCmd->SetParameterName("enable", true);
+    fEnableCmd->SetDefaultValue(true);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fEnableCmd->SetToBeBroadcasted(false);
+
+    fPrintCmd = new G4UIcmdWithoutParameter("/cuts/print", this);
+    fPrintCmd->SetGuidance("Muestra los cortes actuales.");
+    fPrintCmd->SetToBeBroadcasted(false);
+
+    fCompareCmd = new G4UIcmdWithAnInteger("/cuts/compare", this);
+    fCompareCmd->SetGuidance("Corre N eventos sin cortes y N con los cortes, y compara el tiempo");
+    fCompareCmd->SetGuidance("y los conteos por banda.");
+    fCompareCmd->SetParameterName("events", false);
+    fCompareCmd->SetRange("events > 0");
+    fCompareCmd->AvailableForStates(G4State_Idle);
+    fCompareCmd->SetToBeBroadcasted(false);
+}
+
+// ------------------------------------------------------------
+// Destructor
+// ------------------------------------------------------------
+TerminationMessenger::~TerminationMessenger()
+{
+    delete fKillScoredCmd;
+    delete fMinEnergyCmd;
+    delete fMaxTimeCmd;
+    delete fAcceptanceCmd;
+    delete fEnableCmd;
+    delete fPrintCmd;
+    delete fCompareCmd;
+    delete fCutsDir;
+}
+
+// ------------------------------------------------------------
+// Conecta los comandos con TerminationCuts
+// ------------------------------------------------------------
+void TerminationMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+    if (command == fKillScoredCmd) {
+        fCuts->SetKillScored(fKillScoredCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fMinEnergyCmd) {
+        fCuts->SetMinEnergy(fMinEnergyCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fMaxTimeCmd) {
+        G4double time = fMaxTimeCmd->GetNewDoubleValue(newValue);
+        fCuts->SetMaxTime(time > 0. ? time : DBL_MAX);
+    }
+    else if (command == fAcceptanceCmd) {
+        fCuts->SetAcceptanceMargin(fAcceptanceCmd->GetNewDoubleValue(newValue));
+    }
+    else if (command == fEnableCmd) {
+        fCuts->SetEnabled(fEnableCmd->GetNewBoolValue(newValue));
+    }
+    else if (command == fPrintCmd) {
+        fCuts->Print();
+    }
+    else if (command == fCompareCmd) {
+        TerminationComparison comparison(fCuts);
+        comparison.Run(fCompareCmd->GetNewIntValue(newValue));
+    }
+}
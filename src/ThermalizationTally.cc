@@ -0,0 +1,164 @@
+#include "ThermalizationTally.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+const G4String ThermalizationTally::kName = "ThermalizationTally";
+
+namespace {
+
+// Bordes de los bines: 10 por década desde 1 meV y desde 0.1 ns
+constexpr G4double kLog10EMin = -3.;   // log10(E/eV)
+constexpr G4double kLog10TMin = -1.;   // log10(t/ns)
+constexpr G4double kBinsPerDecade = 10.;
+
+char ByteOrder()
+{
+    const std::uint16_t one = 1;
+    return (*reinterpret_cast<const char*>(&one) == 1) ? '<' : '>';
+}
+
+}
+
+// ------------------------------------------------------------
+// Constructor
+// ------------------------------------------------------------
+ThermalizationTally::ThermalizationTally()
+ : G4VAccumulable(kName),
+   fMap(std::size_t(kTimeBins)*kEnergyBins, 0.)
+{
+    Reset();
+}
+
+void ThermalizationTally::SetBandEdges(const std::vector<G4double>& edges)
+{
+    fEdges.assign(edges.begin(), edges.begin() + std::min<std::size_t>(edges.size(), kMaxEdges));
+}
+
+G4int ThermalizationTally::EdgeIndex(G4double kineticEnergy) const
+{
+    // Número de límites <= E: los límites de índice >= este ya se cruzaron
+    return std::upper_bound(fEdges.begin(), fEdges.end(), kineticEnergy) - fEdges.begin();
+}
+
+// ------------------------------------------------------------
+// Llenado
+// ------------------------------------------------------------
+void ThermalizationTally::AddCollision(G4int trackID, G4double kineticEnergy, G4double localTime,
+                                      G4double weight, G4double vertexEnergy)
+{
+    // Las trazas se siguen una a la vez: un ID nuevo es un neutrón nuevo
+    if (trackID != fTrackID) {
+        fTrackID = trackID;
+        fReached = EdgeIndex(vertexEnergy);
+    }
+
+    // Límites cruzados en esta colisión (puede saltar varios)
+    G4int index = EdgeIndex(kineticEnergy);
+    G4double t = localTime/ns;
+    for (G4int k = index; k < fReached; ++k) {
+        fSumW[k] += weight;
+        fSumWT[k] += weight*t;
+        fSumWT2[k] += weight*t*t;
+    }
+    fReached = std::min(fReached, index);
+
+    // Mapa energía-tiempo (lo que cae fuera del rango no se cuenta)
+    if (kineticEnergy <= 0. || t <= 0.) return;
+    G4int ie = G4int(std::floor((std::log10(kineticEnergy/eV) - kLog10EMin)*kBinsPerDecade));
+    G4int it = G4int(std::floor((std::log10(t) - kLog10TMin)*kBinsPerDecade));
+    if (ie < 0 || ie >= kEnergyBins || it < 0 || it >= kTimeBins) return;
+    fMap[std::size_t(it)*kEnergyBins + ie] += weight;
+}
+
+// ------------------------------------------------------------
+// G4VAccumulable
+// ------------------------------------------------------------
+void ThermalizationTally::Merge(const G4VAccumulable& other)
+{
+    const auto& tally = static_cast<const ThermalizationTally&>(other);
+    for (std::size_t i = 0; i < fMap.size(); ++i) fMap[i] += tally.fMap[i];
+    for (G4int k = 0; k < kMaxEdges; ++k) {
+        fSumW[k] += tally.fSumW[k];
+        fSumWT[k] += tally.fSumWT[k];
+        fSumWT2[k] += tally.fSumWT2[k];
+    }
+}
+
+void ThermalizationTally::Reset()
+{
+    std::fill(fMap.begin(), fMap.end(), 0.);
+    std::fill(fSumW, fSumW + kMaxEdges, 0.);
+    std::fill(fSumWT, fSumWT + kMaxEdges, 0.);
+    std::fill(fSumWT2, fSumWT2 + kMaxEdges, 0.);
+    fTrackID = -1;
+}
+
+// ------------------------------------------------------------
+// Reporte
+// ------------------------------------------------------------
+void ThermalizationTally::Print(G4int nEvents) const
+{
+    if (!fEnabled || fEdges.empty() || nEvents <= 0) return;
+
+    G4cout << "  Termalización en el bloque:  neutrones/evento   t medio (ns)   σ (ns)" << G4endl;
+    for (std::size_t k = 0; k < fEdges.size(); ++k) {
+        G4double w = fSumW[k];
+        G4double mean = (w > 0.) ? fSumWT[k]/w : 0.;
+        G4double sigma = (w > 0.) ? std::sqrt(std::max(0., fSumWT2[k]/w - mean*mean)) : 0.;
+        std::ostringstream label;
+        label << "E < " << fEdges[k]/eV << " eV";
+        G4cout << "    " << std::setw(16) << std::left << label.str() << std::right
+               << std::setw(16) << w/nEvents << std::setw(15) << mean << std::setw(10) << sigma
+               << G4endl;
+    }
+}
+
+void ThermalizationTally::Write(const G4String& base, G4int nEvents) const
+{
+    if (!fEnabled || nEvents <= 0) return;
+
+    // Tiempos hasta cada límite. Error de la media σ/sqrt(Σpeso), exacto
+    // sin muestreo por importancia (pesos 1)
+    std::ofstream csv(base + "_thermalization.csv");
+    csv << "# Eventos: " << nEvents << "\n";
+    csv << "Limite_eV,NeutronesPorEvento,TiempoMedio_ns,Sigma_ns,ErrorMedia_ns\n";
+    for (std::size_t k = 0; k < fEdges.size(); ++k) {
+        G4double w = fSumW[k];
+        G4double mean = (w > 0.) ? fSumWT[k]/w : 0.;
+        G4double sigma = (w > 0.) ? std::sqrt(std::max(0., fSumWT2[k]/w - mean*mean)) : 0.;
+        csv << fEdges[k]/eV << "," << w/nEvents << "," << mean << "," << sigma << ","
+            << (w > 0. ? sigma/std::sqrt(w) : 0.) << "\n";
+    }
+
+    // Mapa de colisiones por neutrón fuente
+    std::vector<float> map(fMap.size());
+    for (std::size_t i = 0; i < fMap.size(); ++i) map[i] = float(fMap[i]/nEvents);
+    std::ofstream bin(base + "_thermalization.bin", std::ios::binary);
+    bin.write(reinterpret_cast<const char*>(map.data()), map.size()*sizeof(float));
+
+    std::ofstream json(base + "_thermalization.json");
+    json << "{\n  \"shape\": [" << kTimeBins << ", " << kEnergyBins << "],\n"
+         << "  \"axes\": [\"tiempo\", \"energia\"],\n"
+         << "  \"dtype\": \"" << ByteOrder() << "f4\",\n"
+         << "  \"map\": \"" << base << "_thermalization.bin\",\n"
+         << "  \"units\": \"colisiones por neutron fuente\",\n"
+         << "  \"events\": " << nEvents << ",\n"
+         << "  \"log10_energy_eV\": [" << kLog10EMin << ", " << kLog10EMin + kEnergyBins/kBinsPerDecade << "],\n"
+         << "  \"log10_time_ns\": [" << kLog10TMin << ", " << kLog10TMin + kTimeBins/kBinsPerDecade << "]\n"
+         << "}\n";
+
+    if (!csv || !bin || !json) {
+        G4ExceptionDescription ed;
+        ed << "No se pudo escribir " << base << "_thermalization.*";
+        G4Exception("ThermalizationTally::Write", "Flux004", JustWarning, ed);
+        return;
+    }
+    G4cout << "  Termalización guardada en '" << base << "_thermalization.csv'" << G4endl;
+}
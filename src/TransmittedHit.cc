@@ -0,0 +1,4 @@
+#include "TransmittedHit.hh"
+
+// Un pool de hits por hilo de trabajo
+G4ThreadLocal G4Allocator<TransmittedHit>* TransmittedHitAllocator = nullptr;
@@ -1,95 +1,69 @@
 #include "TransmittedSD.hh"
 #include "G4Step.hh"
-#include "G4ParticleDefinition.hh"
-#include "G4ParticleTable.hh"
-#include "G4SystemOfUnits.hh"
-#include "G4AnalysisManager.hh"
-#include "G4RunManager.hh" // ¡Necesario para el EventID!
-#include "G4VProcess.hh" // ¡Necesario para el nombre del proceso!
+#include "G4Neutron.hh"
+#include "G4SDManager.hh"
+#include "G4HCofThisEvent.hh"
+
+const G4String TransmittedSD::kHitsCollectionName = "TransmittedSD/TransmittedHitsCollection";
 
 TransmittedSD::TransmittedSD(const G4String& name)
- : G4VSensitiveDetector(name)
-{}
+ : G4VSensitiveDetector(name),
+   fHitsCollection(nullptr),
+   fHCID(-1),
+   fNeutron(G4Neutron::Definition())
+{
+    collectionName.insert("TransmittedHitsCollection");
+}
 
 TransmittedSD::~TransmittedSD() = default;
 
+void TransmittedSD::Initialize(G4HCofThisEvent* hce)
+{
+    // Una colección nueva por evento; el G4HCofThisEvent la libera al final
+    fHitsCollection = new TransmittedHitsCollection(SensitiveDetectorName, collectionName[0]);
+    if (fHCID < 0) fHCID = G4SDManager::GetSDMpointer()->GetCollectionID(fHitsCollection);
+    hce->AddHitsCollection(fHCID, fHitsCollection);
+    fLastTrackID = -1;
+}
+
 G4bool TransmittedSD::ProcessHits(G4Step* aStep, G4TouchableHistory*)
 {
     // Queremos el estado del neutrón JUSTO ANTES de entrar al volumen
     G4StepPoint* pre = aStep->GetPreStepPoint();
+    auto track = aStep->GetTrack();
 
-    // Condición: El paso debe haber sido definido por una frontera geométrica
-    if (pre->GetStepStatus() == fGeomBoundary) {
-        
-        auto track = aStep->GetTrack();
-        auto particle = track->GetDefinition();
-
-        // Solo nos interesan los neutrones
-        if (particle->GetParticleName() == "neutron") {
-            
-            auto analysisManager = G4AnalysisManager::Instance();
-            G4int ntupleID = 0; // El ID de nuestra Ntuple es 0
-
-            // --- Llenar Histograma (ID=0) ---
-            G4double kinE_eV = pre->GetKineticEnergy() / eV;
-            analysisManager->FillH1(0, kinE_eV);
-
-            // --- Llenar la Ntuple (ID=0) ---
-            // (Los IDs de columna empiezan en 0)
-
-            // Col 0: EventID
-            analysisManager->FillNtupleIColumn(ntupleID, 0, G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID());
-            // Col 1: TrackID
-            analysisManager->FillNtupleIColumn(ntupleID, 1, track->GetTrackID());
-            // Col 2: ParentID
-            analysisManager->FillNtupleIColumn(ntupleID, 2, track->GetParentID());
-            
-            // Col 3: KineticEnergy_eV (la energía que tiene al entrar)
-            analysisManager->FillNtupleDColumn(ntupleID, 3, kinE_eV);
-            // Col 4: Tiempo (el tiempo que tardó en llegar)
-            analysisManager->FillNtupleDColumn(ntupleID, 4, pre->GetGlobalTime() / ns);
+    // Si el paso anterior de la traza también fue dentro del detector, la
+    // frontera es entre dos píxeles: no es una entrada nueva
+    G4bool inside = (track->GetTrackID() == fLastTrackID &&
+                     track->GetCurrentStepNumber() == fLastStepNumber + 1);
+    fLastTrackID = track->GetTrackID();
+    fLastStepNumber = track->GetCurrentStepNumber();
 
-            // Col 5, 6, 7: Posición (dónde tocó el detector)
-            G4ThreeVector pos = pre->GetPosition();
-            analysisManager->FillNtupleDColumn(ntupleID, 5, pos.x() / mm);
-            analysisManager->FillNtupleDColumn(ntupleID, 6, pos.y() / mm);
-            analysisManager->FillNtupleDColumn(ntupleID, 7, pos.z() / mm);
-
-            // Col 8: Longitud de la traza (cuánto viajó hasta aquí)
-            analysisManager->FillNtupleDColumn(ntupleID, 8, track->GetTrackLength() / mm);
-
-            // Col 9: Número de Pasos (cuántas colisiones tuvo hasta aquí)
-            analysisManager->FillNtupleIColumn(ntupleID, 9, track->GetCurrentStepNumber());
-
-            // Col 10: Volumen (El nombre del volumen que estamos tocando)
-            // (track->GetVolume() es el volumen actual, o sea, el SD)
-            analysisManager->FillNtupleSColumn(ntupleID, 10, track->GetVolume()->GetName());
-            
-            // Col 11: Proceso (El proceso que llevó a este paso)
-            // (Para un cruce de frontera, casi siempre será "Transportation")
-            const G4VProcess* process = pre->GetProcessDefinedStep();
-            G4String processName = "N/A";
-            if (process) processName = process->GetProcessName();
-            analysisManager->FillNtupleSColumn(ntupleID, 11, processName);
-
-            // Col 12, 13, 14: Dirección 
-            G4ThreeVector direction = pre->GetMomentumDirection();
-            analysisManager->FillNtupleDColumn(ntupleID, 12, direction.x());
-            analysisManager->FillNtupleDColumn(ntupleID, 13, direction.y());
-            analysisManager->FillNtupleDColumn(ntupleID, 14, direction.z());
-
-            // Añadir la fila a la Ntuple
-            analysisManager->AddNtupleRow(ntupleID);
-            
-
-
-
-            
-            // track->SetTrackStatus(fStopAndKill);
-
-            return true;
-        }
+    // Condición: El paso debe haber sido definido por una frontera geométrica
+    if (pre->GetStepStatus() != fGeomBoundary || inside) return false;
+
+    // Solo nos interesan los neutrones (comparación de punteros, no de nombres)
+    if (track->GetDefinition() != fNeutron) return false;
+
+    // Sólo se guarda el estado; histogramas, conteos y ntuple se llenan
+    // al final del evento (EventAction::EndOfEventAction)
+    auto hit = new TransmittedHit();
+    hit->SetTrackID(track->GetTrackID());
+    hit->SetParentID(track->GetParentID());
+    hit->SetKineticEnergy(pre->GetKineticEnergy());        // energía al entrar
+    hit->SetGlobalTime(pre->GetGlobalTime());              // tiempo de llegada
+    hit->SetPosition(pre->GetPosition());                  // dónde tocó el detector
+    hit->SetDirection(pre->GetMomentumDirection());
+    hit->SetTrackLength(track->GetTrackLength());          // cuánto viajó hasta aquí
+    hit->SetStepNumber(track->GetCurrentStepNumber());     // pasos hasta aquí
+    hit->SetVolume(track->GetVolume());                    // volumen actual (el SD)
+    hit->SetProcess(pre->GetProcessDefinedStep());         // casi siempre Transportation
+    hit->SetWeight(pre->GetWeight());                      // 1 salvo con muestreo (-b)
+    if (fPixelColumns > 0) {                               // (iy, ix) de las réplicas
+        auto touchable = pre->GetTouchable();
+        hit->SetPixel(touchable->GetReplicaNumber(0)*fPixelColumns + touchable->GetReplicaNumber(1));
     }
+    fHitsCollection->insert(hit);
 
-    return false;
+    return true;
 }
@@ -0,0 +1,176 @@
+import argparse
+import datetime
+import os
+import re
+import subprocess
+import sys
+
+# --- Benchmark y regresión de física (ctest -L regression) ---
+# Uso: python3 regression.py caso --exe ./Neutron_Thermalization --golden dir
+#                            [--candidates dir] [--events N] [--tolerance Z] [--update]
+#
+# Cada caso corre un macro de referencia con semillas por evento fijas
+# (/seed/perEvent), así que el run secuencial y el multihilo de una misma
+# geometría dan el mismo espectro y comparten la referencia. Se mide:
+#   - eventos/s y tiempo de arranque (salida del ejecutable),
+#   - memoria máxima (RSS del proceso, os.wait4),
+# y el espectro transmitido en 15 bandas logarítmicas (1 meV a 10 MeV) se
+# compara con la referencia guardada en <golden>/<geometría>_<modo>.csv:
+# cada banda debe estar a menos de --tolerance σ y χ²/ndf debe ser < 3.
+#
+# Sin referencia el caso falla: el run actual se guarda como candidata en
+# --candidates (el directorio de build, nunca el árbol de fuentes) para
+# revisarla y copiarla a tests/golden/. Sólo --update escribe en --golden.
+# Las mediciones se agregan a bench_results.csv en el directorio de trabajo.
+
+# nombre: (media longitud del bloque en cm, hilos (0: secuencial), muestreo por importancia)
+CASES = {
+    "thin_serial":         (0.5, 0, False),
+    "thin_mt":             (0.5, 2, False),
+    "thick_serial":        (5.0, 0, False),
+    "thick_mt":            (5.0, 2, False),
+    "thick_biased_serial": (5.0, 0, True),
+    "thick_biased_mt":     (5.0, 2, True),
+}
+
+parser = argparse.ArgumentParser(description="Caso de benchmark y regresión de física")
+parser.add_argument("case", choices=sorted(CASES))
+parser.add_argument("--exe", default="./Neutron_Thermalization")
+parser.add_argument("--golden", default="golden", help="directorio de las referencias")
+parser.add_argument("--candidates", default="golden_candidates",
+                    help="dónde guardar la referencia candidata si falta la de --golden")
+parser.add_argument("--events", type=int, default=20000)
+parser.add_argument("--seed", type=int, default=20240611)
+parser.add_argument("--tolerance", type=float, default=4.0, help="máximo |z| por banda")
+parser.add_argument("--update", action="store_true", help="reescribe la referencia")
+args = parser.parse_args()
+
+half_z, threads, biased = CASES[args.case]
+golden_name = f"{'thin' if half_z < 1 else 'thick'}_{'biased' if biased else 'analog'}.csv"
+golden_path = os.path.join(args.golden, golden_name)
+
+# ------------------------------------------------------------
+# Macro de referencia
+# ------------------------------------------------------------
+edges = " ".join(f"{10 ** (-3 + k * 10 / 14):.4g}" for k in range(15))  # 1 meV ... 10 MeV
+name = f"regression_{args.case}"
+lines = ["/control/verbose 0", "/run/verbose 0", f"/detector/setParaffinZ {half_z} cm"]
+if biased:
+    lines += ["/biasing/cells 10", "/biasing/ratio 2"]
+lines += ["/run/initialize",
+          "/gun/particle neutron", "/gun/energy 4.2 MeV",
+          f"/gun/position 0 0 {-(half_z + 0.1)} cm", "/gun/direction 0 0 1",
+          f"/tally/bands {edges} eV",
+          "/seed/perEvent true", f"/seed/master {args.seed}",
+          f"/run/beamOn {args.events}"]
+with open(name + ".mac", "w") as f:
+    f.write("\n".join(lines) + "\n")
+
+command = [args.exe, name + ".mac", "-o", name, "--no-cache"]
+command += ["-m", "serial"] if threads == 0 else ["-m", "mt", "-t", str(threads)]
+if biased:
+    command.append("-b")
+
+# ------------------------------------------------------------
+# Run y mediciones
+# ------------------------------------------------------------
+with open(name + ".log", "w") as log:
+    proc = subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT)
+    _, status, usage = os.wait4(proc.pid, 0)
+with open(name + ".log") as log:
+    out = log.read()
+
+rate = re.search(r"Eventos/s:\s+([0-9.eE+-]+)", out)
+startup = re.search(r"Arranque total:\s+([0-9.eE+-]+)", out)
+if status != 0 or not rate or not os.path.exists(name + "_tallies.csv"):
+    print(f"❌ {args.case}: el run falló (código {status}, ver {name}.log)")
+    sys.exit(1)
+rate = float(rate.group(1))
+startup = float(startup.group(1)) if startup else float("nan")
+rss_mb = usage.ru_maxrss / 1024.  # Linux: KiB
+
+
+def read_spectrum(path):
+    """[(banda, por evento, error por evento)] de un <nombre>_tallies.csv."""
+    rows = []
+    with open(path) as f:
+        events = None
+        for line in f:
+            if line.startswith("# Eventos:"):
+                events = int(line.split(":")[1])
+            elif line.strip() and not line.startswith(("#", "Banda,")):
+                label, _, _, n, error = line.strip().split(",")[:5]
+                if label != "Detectados":
+                    rows.append((label, float(n) / events, float(error) / events))
+    return rows
+
+
+def read_golden(path):
+    with open(path) as f:
+        return [(label, float(n), float(error))
+                for label, n, error in (line.strip().split(",") for line in f
+                                        if line.strip() and not line.startswith(("#", "Banda,")))]
+
+
+spectrum = read_spectrum(name + "_tallies.csv")
+
+# ------------------------------------------------------------
+# Comparación con la referencia
+# ------------------------------------------------------------
+def write_golden(directory):
+    os.makedirs(directory, exist_ok=True)
+    path = os.path.join(directory, golden_name)
+    with open(path, "w") as f:
+        f.write(f"# Caso: {args.case}, {args.events} eventos, semilla {args.seed}\n")
+        f.write("Banda,PorEvento,ErrorPorEvento\n")
+        for label, n, error in spectrum:
+            f.write(f"{label},{n!r},{error!r}\n")
+    return path
+
+
+result = "referencia"
+chi2, ndf, worst = 0., 0, (0., "")
+if args.update:
+    print(f"⚠️ {args.case}: referencia reescrita en '{write_golden(args.golden)}'")
+elif not os.path.exists(golden_path):
+    result = "SIN_REFERENCIA"
+    print(f"❌ {args.case}: no existe la referencia '{golden_path}'; candidata guardada en "
+          f"'{write_golden(args.candidates)}' (revisarla y copiarla a {args.golden}/)")
+else:
+    golden = read_golden(golden_path)
+    if [g[0] for g in golden] != [s[0] for s in spectrum]:
+        print(f"❌ {args.case}: las bandas no coinciden con la referencia '{golden_path}'")
+        sys.exit(1)
+    for (label, n, e), (_, n0, e0) in zip(spectrum, golden):
+        if e * e + e0 * e0 == 0.:
+            if n != n0:
+                chi2, worst = float("inf"), (float("inf"), label)
+            continue
+        z = (n - n0) / (e * e + e0 * e0) ** 0.5
+        chi2 += z * z
+        ndf += 1
+        if abs(z) > abs(worst[0]):
+            worst = (z, label)
+    ok = abs(worst[0]) <= args.tolerance and (ndf == 0 or chi2 / ndf < 3.)
+    result = "ok" if ok else "DISTINTO"
+
+print(f"🔹 {args.case}: {rate:.0f} eventos/s, arranque {startup:.2f} s, RSS {rss_mb:.0f} MB")
+if result not in ("referencia", "SIN_REFERENCIA"):
+    print(f"   espectro vs referencia: χ²/ndf = {chi2:.1f}/{ndf}, peor banda {worst[1]} ({worst[0]:+.1f} σ)")
+
+results = "bench_results.csv"
+new = not os.path.exists(results)
+with open(results, "a") as f:
+    if new:
+        f.write("Fecha,Caso,Eventos,EventosPorSegundo,Arranque_s,RSS_MB,Chi2,Ndf,Resultado\n")
+    f.write(f"{datetime.datetime.now().isoformat(timespec='seconds')},{args.case},{args.events},"
+            f"{rate},{startup},{rss_mb},{chi2},{ndf},{result}\n")
+
+if result == "referencia":
+    sys.exit(0)
+if result == "SIN_REFERENCIA":
+    sys.exit(1)
+if result != "ok":
+    print(f"❌ {args.case}: el espectro cambió respecto de la referencia")
+    sys.exit(1)
+print(f"✅ {args.case}: espectro compatible con la referencia")